@@ -0,0 +1,49 @@
+// Copy cost of AnelQuadrosLuma.put per camera resolution (HD, FullHD, 4K), with tightly packed rows and with rows
+// padded to a 64-byte stride as some cameras deliver them, while one slot stays pinned so the writer keeps skipping
+// it. Each case stores `frames` frames into the default 4K-sized ring after one warm-up pass that allocates the slots.
+//
+//   dart run benchmark/anel_quadros_benchmark.dart [frames, default 600]
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/anel_quadros.dart';
+
+import 'boletos_aleatorios.dart';
+
+const Map<String, List<int>> _resolucoes = {
+  'HD': [1280, 720],
+  'FullHD': [1920, 1080],
+  '4K': [3840, 2160],
+};
+
+void main(List<String> args) {
+  var frames = args.isEmpty ? 600 : int.parse(args[0]);
+  var random = Random(26);
+
+  for (var resolucao in _resolucoes.entries) {
+    var width = resolucao.value[0], height = resolucao.value[1];
+    for (var stride in [width, (width + 64) ~/ 64 * 64]) {
+      var plane = Uint8List(stride * height);
+      for (var i = 0; i < plane.length; i += 4096) {
+        plane[i] = random.nextInt(256);
+      }
+      var anel = AnelQuadrosLuma();
+      for (var id = 0; id < anel.capacity; id++) {
+        anel.put(id, plane, width, height, rowStride: stride);
+      }
+      anel.pin(anel.capacity - 1);
+
+      var relogio = Stopwatch()..start();
+      var guardados = medir('put, ${resolucao.key} ${width}x$height, stride $stride', () {
+        var guardados = 0;
+        for (var id = anel.capacity; id < anel.capacity + frames; id++) {
+          if (anel.put(id, plane, width, height, rowStride: stride)) guardados++;
+        }
+        return guardados;
+      }, frames);
+      var micros = relogio.elapsedMicroseconds;
+      print('  ${(micros / frames).toStringAsFixed(0)} us per frame, '
+          '${(width * height * frames / micros / 1000).toStringAsFixed(2)} GB/s, $guardados stored');
+    }
+  }
+}
@@ -0,0 +1,43 @@
+// Bank name lookup on the direct-indexed registry (bancoPorCodigo) against a Map<String, String> keyed by the
+// three-digit code sliced from the barcode string, as calculaLinha's campo1 would give it.
+//
+//   dart run benchmark/bancos_benchmark.dart [lookups, default 10000000]
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/bancos.dart';
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+
+import 'boletos_aleatorios.dart';
+
+void main(List<String> args) {
+  var n = args.isEmpty ? 10000000 : int.parse(args[0]);
+
+  // A few thousand distinct barcodes, looked up round robin, so both sides read from cache-resident inputs.
+  var random = Random(31);
+  var digits = Uint8List(BarraCompacta.length);
+  var packed = <BarraCompacta>[];
+  var strings = <String>[];
+  for (var i = 0; i < 4096; i++) {
+    boletoAleatorio(random, digits);
+    packed.add(BarraCompacta.fromDigits(digits)!);
+    strings.add(comoTexto(digits));
+  }
+  var mapa = {for (var banco in bancos) banco.codigoFormatado: banco.nomeCurto};
+
+  medir('bancoPorCodigo(packed.banco)', () {
+    var tamanho = 0;
+    for (var i = 0; i < n; i++) {
+      tamanho += bancoPorCodigo(packed[i & 4095].banco)?.nomeCurto.length ?? 0;
+    }
+    return tamanho;
+  }, n);
+
+  medir('Map<String, String>[barcode.substring(0, 3)]', () {
+    var tamanho = 0;
+    for (var i = 0; i < n; i++) {
+      tamanho += mapa[strings[i & 4095].substring(0, 3)]?.length ?? 0;
+    }
+    return tamanho;
+  }, n);
+}
@@ -0,0 +1,78 @@
+// Memory and lookup cost of a set of boleto barcodes kept as Strings (Set<String>) and as ConjuntoBarras.
+//
+//   dart run benchmark/barra_compacta_benchmark.dart [codes, default 10000000]
+//
+// Memory is the growth of the process RSS while each set is built, so the packed set is built first. For AOT numbers
+// compile it with `dart compile exe` first.
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+
+import 'boletos_aleatorios.dart';
+
+void main(List<String> args) {
+  var n = args.isEmpty ? 10000000 : int.parse(args[0]);
+  var digits = Uint8List(BarraCompacta.length);
+  print('$n codes');
+
+  medir('generate only', () {
+    var random = Random(1);
+    for (var i = 0; i < n; i++) {
+      boletoAleatorio(random, digits);
+    }
+  }, n);
+
+  var rss = ProcessInfo.currentRss;
+  var packed = medir('ConjuntoBarras add', () {
+    var random = Random(1);
+    var set = ConjuntoBarras(n);
+    for (var i = 0; i < n; i++) {
+      set.add(BarraCompacta.fromDigits(boletoAleatorio(random, digits))!);
+    }
+    return set;
+  }, n);
+  print('ConjuntoBarras RSS growth: ${(ProcessInfo.currentRss - rss) >> 20} MiB');
+
+  medir('ConjuntoBarras contains, hits', () {
+    var random = Random(1), encontrados = 0;
+    for (var i = 0; i < n; i++) {
+      if (packed.contains(BarraCompacta.fromDigits(boletoAleatorio(random, digits))!)) encontrados++;
+    }
+    return encontrados;
+  }, n);
+  medir('ConjuntoBarras contains, misses', () {
+    var random = Random(2), encontrados = 0;
+    for (var i = 0; i < n; i++) {
+      if (packed.contains(BarraCompacta.fromDigits(boletoAleatorio(random, digits))!)) encontrados++;
+    }
+    return encontrados;
+  }, n);
+
+  rss = ProcessInfo.currentRss;
+  var strings = medir('Set<String> add', () {
+    var random = Random(1);
+    var set = <String>{};
+    for (var i = 0; i < n; i++) {
+      set.add(comoTexto(boletoAleatorio(random, digits)));
+    }
+    return set;
+  }, n);
+  print('Set<String> RSS growth: ${(ProcessInfo.currentRss - rss) >> 20} MiB');
+
+  medir('Set<String> contains, hits', () {
+    var random = Random(1), encontrados = 0;
+    for (var i = 0; i < n; i++) {
+      if (strings.contains(comoTexto(boletoAleatorio(random, digits)))) encontrados++;
+    }
+    return encontrados;
+  }, n);
+  medir('Set<String> contains, misses', () {
+    var random = Random(2), encontrados = 0;
+    for (var i = 0; i < n; i++) {
+      if (strings.contains(comoTexto(boletoAleatorio(random, digits)))) encontrados++;
+    }
+    return encontrados;
+  }, n);
+}
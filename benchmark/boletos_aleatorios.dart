@@ -0,0 +1,61 @@
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+
+const List<int> _bancos = [1, 33, 104, 237, 341, 422, 745, 748, 756];
+
+// Fills `digits` with a random boleto barcode whose general check digit matches: one of a few common banks, currency
+// 9, a due date factor in the current range, an amount below R$ 100.000,00 and a random free field.
+Uint8List boletoAleatorio(Random random, Uint8List digits) {
+  var banco = _bancos[random.nextInt(_bancos.length)];
+  digits[0] = banco ~/ 100;
+  digits[1] = banco ~/ 10 % 10;
+  digits[2] = banco % 10;
+  digits[3] = 9;
+  _escrever(digits, 5, 4, 1000 + random.nextInt(9000));
+  _escrever(digits, 9, 10, random.nextInt(10000000));
+  for (var i = 19; i < 44; i++) {
+    digits[i] = random.nextInt(10);
+  }
+  digits[4] = digitoModulo11Banco(digits);
+  return digits;
+}
+
+void _escrever(Uint8List digits, int inicio, int tamanho, int valor) {
+  for (var i = inicio + tamanho - 1; i >= inicio; i--) {
+    digits[i] = valor % 10;
+    valor ~/= 10;
+  }
+}
+
+// Writes a journal file of `n` random boletos at `caminho`, in the record layout of DiarioLeituras, so benchmarks
+// can load it with DiarioLeituras.abrir (one sort for the index) instead of n add() calls.
+Future<void> escreverDiarioAleatorio(String caminho, Random random, int n) async {
+  var registros = ByteData(n * 32);
+  var digits = Uint8List(BarraCompacta.length);
+  var momento = DateTime.now().millisecondsSinceEpoch;
+  for (var i = 0; i < n; i++) {
+    var barcode = BarraCompacta.fromDigits(boletoAleatorio(random, digits))!;
+    registros
+      ..setInt64(i * 32, barcode.hi, Endian.little)
+      ..setInt64(i * 32 + 8, barcode.mid, Endian.little)
+      ..setInt64(i * 32 + 16, barcode.lo, Endian.little)
+      ..setInt64(i * 32 + 24, momento, Endian.little);
+  }
+  await File(caminho).writeAsBytes(registros.buffer.asUint8List());
+}
+
+String comoTexto(Uint8List digits) => String.fromCharCodes(digits.map((digit) => digit + 0x30));
+
+// Runs `corpo` once and prints its wall time, with a rate when `itens` is given.
+T medir<T>(String nome, T Function() corpo, [int itens = 0]) {
+  var relogio = Stopwatch()..start();
+  var resultado = corpo();
+  var micros = relogio.elapsedMicroseconds;
+  var taxa = itens > 0 && micros > 0 ? ', ${(itens / micros * 1e6).round()}/s' : '';
+  print('$nome: ${(micros / 1000).toStringAsFixed(1)} ms$taxa');
+  return resultado;
+}
@@ -0,0 +1,80 @@
+// Fuzzy search over 1M digitable lines: building the 4-gram index, queries with one digit wrong, missing or extra,
+// and the incremental update after new scans.
+//
+//   dart run benchmark/busca_ngram_benchmark.dart [lines, default 1000000] [queries, default 1000]
+//
+// The journal is loaded from a temporary journal file, since DiarioLeituras.abrir builds the prefix index with a single
+// sort while add() keeps it sorted entry by entry.
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/busca_ngram.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+
+import 'boletos_aleatorios.dart';
+
+Future<void> main(List<String> args) async {
+  var n = args.isEmpty ? 1000000 : int.parse(args[0]);
+  var consultas = args.length < 2 ? 1000 : int.parse(args[1]);
+  var random = Random(48);
+
+  var diretorio = await Directory.systemTemp.createTemp('busca_ngram');
+  var caminho = '${diretorio.path}/journal.bin';
+  await escreverDiarioAleatorio(caminho, random, n);
+
+  var relogio = Stopwatch()..start();
+  var journal = await DiarioLeituras.abrir(caminho);
+  print('DiarioLeituras.abrir, $n entries: ${relogio.elapsedMilliseconds} ms');
+
+  var indice = IndiceNGram(journal);
+  medir('IndiceNGram.atualizar, $n lines', indice.atualizar, n);
+
+  // Fragments of 12 to 20 digits of stored lines, each with one edit.
+  var fragmentos = <String>[];
+  var linha = Uint8List(47);
+  for (var q = 0; q < consultas; q++) {
+    journal.barcodeAt(random.nextInt(n)).linhaDigitsInto(linha);
+    var tamanho = 12 + random.nextInt(9);
+    var inicio = random.nextInt(47 - tamanho);
+    var fragmento = linha.sublist(inicio, inicio + tamanho).toList();
+    var posicao = random.nextInt(tamanho);
+    switch (q % 3) {
+      case 0:
+        fragmento[posicao] = (fragmento[posicao] + 1) % 10;
+        break;
+      case 1:
+        fragmento.removeAt(posicao);
+        break;
+      default:
+        fragmento.insert(posicao, random.nextInt(10));
+    }
+    fragmentos.add(fragmento.join());
+  }
+
+  var tempos = <int>[];
+  var encontrados = 0;
+  for (var fragmento in fragmentos) {
+    relogio
+      ..reset()
+      ..start();
+    encontrados += indice.buscar(fragmento).length;
+    tempos.add(relogio.elapsedMicroseconds);
+  }
+  tempos.sort();
+  print('buscar, $consultas queries: median ${tempos[tempos.length ~/ 2] / 1000} ms, '
+      'p99 ${tempos[tempos.length * 99 ~/ 100] / 1000} ms, ${encontrados / consultas} results per query');
+
+  var digits = Uint8List(BarraCompacta.length);
+  medir('100 new scans + next query', () {
+    var agora = DateTime.now();
+    for (var i = 0; i < 100; i++) {
+      journal.add(BarraCompacta.fromDigits(boletoAleatorio(random, digits))!, agora);
+    }
+    return indice.buscar(fragmentos.first).length;
+  });
+
+  await journal.fechar();
+  await diretorio.delete(recursive: true);
+}
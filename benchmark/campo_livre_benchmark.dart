@@ -0,0 +1,37 @@
+// lerCampoLivre throughput over a mixed-bank corpus: the random boletos of boletos_aleatorios.dart, five of whose nine
+// banks have a parser, then each parsed bank on its own.
+//
+//   dart run benchmark/campo_livre_benchmark.dart [barcodes, default 10000000]
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/campo_livre.dart';
+
+import 'boletos_aleatorios.dart';
+
+void main(List<String> args) {
+  var n = args.isEmpty ? 10000000 : int.parse(args[0]);
+
+  // A few thousand distinct barcodes, parsed round robin from cache-resident inputs.
+  var random = Random(32);
+  var digits = Uint8List(BarraCompacta.length);
+  var corpus = [for (var i = 0; i < 4096; i++) Uint8List.fromList(boletoAleatorio(random, digits))];
+  _medir('lerCampoLivre, mixed banks', corpus, n);
+
+  for (var banco in [1, 33, 104, 237, 341]) {
+    var doBanco = corpus.where((digits) => digits[0] * 100 + digits[1] * 10 + digits[2] == banco).toList();
+    _medir('lerCampoLivre, bank $banco', doBanco, n);
+  }
+}
+
+void _medir(String nome, List<Uint8List> corpus, int n) {
+  var validos = medir(nome, () {
+    var validos = 0;
+    for (var i = 0; i < n; i++) {
+      if (lerCampoLivre(corpus[i % corpus.length])?.digitosValidos ?? false) validos++;
+    }
+    return validos;
+  }, n);
+  print('  ${corpus.length} distinct barcodes, ${(validos * 100 / n).toStringAsFixed(1)}% with valid check digits');
+}
@@ -0,0 +1,51 @@
+// CNAB 240 payment file of 1M segment J records from a journal of 1M scans: into a byte counter, to measure the
+// writer alone, and into a temporary file with writeFromSync.
+//
+//   dart run benchmark/cnab_remessa_benchmark.dart [segments, default 1000000]
+import 'dart:io';
+import 'dart:math';
+
+import 'package:BarcodeCaptureSimpleSample/cnab_remessa.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+import 'package:BarcodeCaptureSimpleSample/vencimento.dart';
+
+import 'boletos_aleatorios.dart';
+
+const ContaCnab _conta = ContaCnab(
+    banco: 341,
+    nomeBanco: 'Itau Unibanco',
+    inscricao: 12345678000195,
+    convenio: '000123',
+    agencia: 1234,
+    conta: 56789,
+    dvConta: '0',
+    nomeEmpresa: 'Empresa de Teste');
+
+Future<void> main(List<String> args) async {
+  var n = args.isEmpty ? 1000000 : int.parse(args[0]);
+  var random = Random(49);
+  var diretorio = await Directory.systemTemp.createTemp('cnab_remessa');
+  await escreverDiarioAleatorio('${diretorio.path}/journal.bin', random, n);
+  var journal = await DiarioLeituras.abrir('${diretorio.path}/journal.bin');
+  var hoje = diaDeDateTime(DateTime.now());
+  var geracao = DateTime.now();
+  // Builds the calendar tables outside the timed runs.
+  dataDoDia(hoje);
+
+  var bytes = medir('escreverRemessa240, $n segments, to a counter', () {
+    var total = 0;
+    escreverRemessa240(_conta, journal, (_, length) => total += length,
+        nsa: 1, geracao: geracao, diaPagamento: hoje);
+    return total;
+  }, n);
+  print('${bytes >> 20} MiB');
+
+  var arquivo = File('${diretorio.path}/remessa.rem').openSync(mode: FileMode.write);
+  medir('escreverRemessa240, $n segments, to a file', () {
+    escreverRemessa240(_conta, journal, (bloco, length) => arquivo.writeFromSync(bloco, 0, length),
+        nsa: 2, geracao: geracao, diaPagamento: hoje);
+  }, n);
+  arquivo.closeSync();
+  await journal.fechar();
+  await diretorio.delete(recursive: true);
+}
@@ -0,0 +1,65 @@
+// Reconciliation of a CNAB 240 retorno of 1M segment J records against a journal of 1M scans, in records per second:
+// once joining on the barcode and once with the barcodes blanked, joining on the seu número. The retorno files are
+// the payment files escreverRemessa240 writes for the journal, which have the segment J layout the retorno reader
+// expects.
+//
+//   dart run benchmark/cnab_retorno_benchmark.dart [records, default 1000000]
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/cnab_remessa.dart';
+import 'package:BarcodeCaptureSimpleSample/cnab_retorno.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+import 'package:BarcodeCaptureSimpleSample/vencimento.dart';
+
+import 'boletos_aleatorios.dart';
+
+const ContaCnab _conta = ContaCnab(
+    banco: 341,
+    nomeBanco: 'Itau Unibanco',
+    inscricao: 12345678000195,
+    agencia: 1234,
+    conta: 56789,
+    nomeEmpresa: 'Empresa de Teste');
+
+Future<void> main(List<String> args) async {
+  var n = args.isEmpty ? 1000000 : int.parse(args[0]);
+  var random = Random(50);
+  var diretorio = await Directory.systemTemp.createTemp('cnab_retorno');
+  await escreverDiarioAleatorio('${diretorio.path}/journal.bin', random, n);
+  var journal = await DiarioLeituras.abrir('${diretorio.path}/journal.bin');
+
+  var comBarras = '${diretorio.path}/retorno.ret';
+  var semBarras = '${diretorio.path}/retorno_sem_barras.ret';
+  _escrever(journal, comBarras, false);
+  _escrever(journal, semBarras, true);
+
+  for (var caminho in [comBarras, semBarras]) {
+    var relogio = Stopwatch()..start();
+    var conciliacao = (await conciliarRetorno(caminho, journal))!;
+    var micros = relogio.elapsedMicroseconds;
+    print('conciliarRetorno, ${caminho == comBarras ? 'barcode' : 'seu número'} join: ${micros ~/ 1000} ms, '
+        '${(conciliacao.registros / micros * 1e6).round()} records/s, ${conciliacao.conciliados} reconciled, '
+        '${conciliacao.naoRetornados.length} not returned');
+  }
+
+  await journal.fechar();
+  await diretorio.delete(recursive: true);
+}
+
+void _escrever(DiarioLeituras journal, String caminho, bool semBarras) {
+  var arquivo = File(caminho).openSync(mode: FileMode.write);
+  escreverRemessa240(_conta, journal, (bloco, length) {
+    if (semBarras) _apagarBarras(bloco, length);
+    arquivo.writeFromSync(bloco, 0, length);
+  }, nsa: 1, geracao: DateTime.now(), diaPagamento: diaDeDateTime(DateTime.now()));
+  arquivo.closeSync();
+}
+
+// Blanks positions 18-61 of the segment J records in a block of 240-byte records with CRLF.
+void _apagarBarras(Uint8List bloco, int length) {
+  for (var inicio = 0; inicio < length; inicio += 242) {
+    if (bloco[inicio + 7] == 0x33 && bloco[inicio + 13] == 0x4a) bloco.fillRange(inicio + 17, inicio + 61, 0x20);
+  }
+}
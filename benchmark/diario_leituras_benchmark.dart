@@ -0,0 +1,72 @@
+// Keystroke-to-result time of the history search over 100k journal entries, against the 16.7 ms of one frame at
+// 60 Hz. Each keystroke runs what TelaHistorico._buscar runs: buscarPrefixo on the typed text, and the fuzzy search
+// when no line starts with it. Lines are typed digit by digit as printed (with dots and spaces), some with one digit
+// wrong so the later keystrokes fall back to the fuzzy search.
+//
+//   dart run benchmark/diario_leituras_benchmark.dart [entries, default 100000] [lines typed, default 200]
+import 'dart:io';
+import 'dart:math';
+
+import 'package:BarcodeCaptureSimpleSample/busca_ngram.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+
+import 'boletos_aleatorios.dart';
+
+const int _quadroMicros = 16667;
+
+Future<void> main(List<String> args) async {
+  var n = args.isEmpty ? 100000 : int.parse(args[0]);
+  var linhas = args.length < 2 ? 200 : int.parse(args[1]);
+  var random = Random(47);
+
+  var diretorio = await Directory.systemTemp.createTemp('diario_leituras');
+  var caminho = '${diretorio.path}/journal.bin';
+  await escreverDiarioAleatorio(caminho, random, n);
+
+  var relogio = Stopwatch()..start();
+  var journal = await DiarioLeituras.abrir(caminho);
+  print('DiarioLeituras.abrir, $n entries: ${relogio.elapsedMilliseconds} ms');
+  var indice = IndiceNGram(journal);
+  // The index is built on the first fuzzy query; build it here so the keystrokes measure the steady state.
+  medir('IndiceNGram.atualizar, $n lines', indice.atualizar, n);
+
+  var prefixo = <int>[];
+  var difusa = <int>[];
+  var resultados = 0;
+  for (var l = 0; l < linhas; l++) {
+    var linha = journal.barcodeAt(random.nextInt(n)).toLinhaDigitavel().codeUnits.toList();
+    // Every fourth line is typed with a digit wrong past the first field.
+    if (l % 4 == 3) {
+      var posicao = 12 + random.nextInt(linha.length - 12);
+      if (linha[posicao] >= 0x30) linha[posicao] = 0x30 + (linha[posicao] - 0x30 + 1) % 10;
+    }
+    for (var k = 1; k <= linha.length; k++) {
+      var consulta = String.fromCharCodes(linha, 0, k);
+      relogio
+        ..reset()
+        ..start();
+      var resultado = journal.buscarPrefixo(consulta);
+      var tempos = prefixo;
+      if (resultado.isEmpty) {
+        resultado = [for (var encontrado in indice.buscar(consulta)) encontrado.indice];
+        tempos = difusa;
+      }
+      tempos.add(relogio.elapsedMicroseconds);
+      resultados += resultado.length;
+    }
+  }
+  _relatar('buscarPrefixo', prefixo);
+  _relatar('buscarPrefixo + buscar (no prefix match)', difusa);
+  print('${resultados / (prefixo.length + difusa.length)} results per keystroke');
+
+  await journal.fechar();
+  await diretorio.delete(recursive: true);
+}
+
+void _relatar(String nome, List<int> tempos) {
+  if (tempos.isEmpty) return;
+  tempos.sort();
+  var acima = tempos.where((tempo) => tempo > _quadroMicros).length;
+  print('$nome, ${tempos.length} keystrokes: median ${tempos[tempos.length ~/ 2] / 1000} ms, '
+      'p99 ${tempos[tempos.length * 99 ~/ 100] / 1000} ms, max ${tempos.last / 1000} ms, $acima over one frame');
+}
@@ -0,0 +1,45 @@
+// Fines, interest and discounts over 10M boletos, on the calling isolate and split across background isolates.
+//
+//   dart run benchmark/encargos_benchmark.dart [records, default 10000000] [isolates, default: processors]
+//
+// The parallel time includes copying each part to its isolate and the results back.
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/encargos.dart';
+import 'package:BarcodeCaptureSimpleSample/vencimento.dart';
+
+import 'boletos_aleatorios.dart';
+
+Future<void> main(List<String> args) async {
+  var n = args.isEmpty ? 10000000 : int.parse(args[0]);
+  var partes = args.length < 2 ? Platform.numberOfProcessors : int.parse(args[1]);
+  var random = Random(34);
+  var hoje = diaDeDateTime(DateTime.now());
+  var valores = Int64List(n);
+  var vencimentos = Int32List(n);
+  var pagamentos = Int32List(n);
+  for (var i = 0; i < n; i++) {
+    valores[i] = 100 + random.nextInt(10000000);
+    vencimentos[i] = hoje - 60 + random.nextInt(120);
+    pagamentos[i] = hoje - 60 + random.nextInt(120);
+  }
+  const regras = RegrasEncargos(descontoDiarioBasisPoints: 5, descontoMaximoBasisPoints: 300);
+  // Builds the calendar tables outside the timed runs.
+  proximoDiaUtil(hoje);
+
+  var lote = LoteEncargos(valores, vencimentos, pagamentos);
+  medir('calcularEncargos, single isolate', () => calcularEncargos(lote, regras), n);
+  var totalSequencial = lote.totais.fold<int>(0, (soma, total) => soma + total);
+
+  var paralelo = LoteEncargos(valores, vencimentos, pagamentos);
+  var relogio = Stopwatch()..start();
+  await calcularEncargosEmParalelo(paralelo, regras, partes: partes);
+  var micros = relogio.elapsedMicroseconds;
+  print('calcularEncargosEmParalelo, $partes isolates: ${(micros / 1000).toStringAsFixed(1)} ms, '
+      '${(n / micros * 1e6).round()}/s');
+
+  var totalParalelo = paralelo.totais.fold<int>(0, (soma, total) => soma + total);
+  if (totalParalelo != totalSequencial) print('MISMATCH: $totalSequencial != $totalParalelo');
+}
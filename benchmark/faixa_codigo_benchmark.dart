@@ -0,0 +1,48 @@
+// Cost of FaixaCodigo.rectify per megapixel of output strip, over a 4K luma frame with a tilted, perspective-distorted
+// boleto quadrilateral, at a few strip heights; and the PNG size codificarPngCinza gets out of the strips.
+//
+//   dart run benchmark/faixa_codigo_benchmark.dart [strips per height, default 2000]
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/anel_quadros.dart';
+import 'package:BarcodeCaptureSimpleSample/faixa_codigo.dart';
+
+import 'boletos_aleatorios.dart';
+
+// A boleto about 2500 pixels wide seen slightly from the side: the left edge is taller than the right one.
+const List<double> _cantos = [620, 900, 3180, 1010, 3170, 1230, 600, 1180];
+
+void main(List<String> args) {
+  var n = args.isEmpty ? 2000 : int.parse(args[0]);
+  var random = Random(27);
+  var width = 3840, height = 2160;
+  // Vertical bars of random width, as in an ITF barcode, under some noise.
+  var data = Uint8List(width * height);
+  var barras = Uint8List(width);
+  for (var x = 0, cor = 0; x < width; cor ^= 0xe0) {
+    var largura = 2 + random.nextInt(8);
+    barras.fillRange(x, min(x + largura, width), 0x10 + cor);
+    x += largura;
+  }
+  for (var y = 0; y < height; y++) {
+    for (var x = 0; x < width; x++) {
+      data[y * width + x] = barras[x] + random.nextInt(16);
+    }
+  }
+  var frame = QuadroLuma(0, width, height, data);
+
+  for (var altura in [32, 64, 128]) {
+    var faixa = FaixaCodigo.rectify(frame, _cantos, height: altura);
+    var megapixels = faixa.width * faixa.height * n / 1e6;
+    var relogio = Stopwatch()..start();
+    medir('rectify, ${faixa.width}x${faixa.height} strip', () {
+      for (var i = 0; i < n; i++) {
+        faixa = FaixaCodigo.rectify(frame, _cantos, height: altura);
+      }
+    }, n);
+    print('  ${(relogio.elapsedMicroseconds / 1000 / megapixels).toStringAsFixed(1)} ms per megapixel');
+    var png = medir('codificarPngCinza, ${faixa.width}x${faixa.height} strip', () => codificarPngCinza(faixa));
+    print('  ${png.length} bytes');
+  }
+}
@@ -0,0 +1,52 @@
+// Pix BR Code throughput: CRC16 over a large buffer, slice-by-8 against bit at a time, and full lerPix calls on a
+// typical dynamic payload.
+//
+//   dart run benchmark/pix_benchmark.dart [payloads, default 1000000]
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/pix.dart';
+
+import 'boletos_aleatorios.dart';
+
+const String _payload = '00020126580014br.gov.bcb.pix0136123e4567-e12b-12d1-a456-426655440000520400005303986'
+    '54071234.565802BR5913Fulano de Tal6008BRASILIA62140510TXID12345663049D99';
+
+int _crcBitwise(List<int> data) {
+  var crc = 0xffff;
+  for (var byte in data) {
+    crc ^= byte << 8;
+    for (var k = 0; k < 8; k++) {
+      crc = (crc & 0x8000) != 0 ? ((crc << 1) ^ 0x1021) & 0xffff : (crc << 1) & 0xffff;
+    }
+  }
+  return crc;
+}
+
+void main(List<String> args) {
+  var n = args.isEmpty ? 1000000 : int.parse(args[0]);
+  var random = Random(35);
+  var buffer = Uint8List(64 << 20);
+  for (var i = 0; i < buffer.length; i++) {
+    buffer[i] = random.nextInt(256);
+  }
+
+  var mib = buffer.length >> 20;
+  var relogio = Stopwatch()..start();
+  var crc = crc16Ccitt(buffer);
+  print('crc16Ccitt slice-by-8: ${(mib / relogio.elapsedMicroseconds * 1e6).toStringAsFixed(0)} MiB/s');
+  relogio
+    ..reset()
+    ..start();
+  var referencia = _crcBitwise(buffer);
+  print('bitwise CRC16: ${(mib / relogio.elapsedMicroseconds * 1e6).toStringAsFixed(0)} MiB/s');
+  if (crc != referencia) print('MISMATCH: $crc != $referencia');
+
+  medir('lerPix, ${_payload.length}-character payload', () {
+    var validos = 0;
+    for (var i = 0; i < n; i++) {
+      if (lerPix(_payload)?.crcValido == true) validos++;
+    }
+    return validos;
+  }, n);
+}
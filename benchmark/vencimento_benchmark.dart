@@ -0,0 +1,51 @@
+// Bulk due date evaluation: due date factor to day and civil date, and whether a payment on a given day is still
+// within the grace of the next business day, over 10M records. The DateTime version is the date arithmetic it
+// replaces (without holidays, so it does less work than the table version).
+//
+//   dart run benchmark/vencimento_benchmark.dart [records, default 10000000]
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/vencimento.dart';
+
+import 'boletos_aleatorios.dart';
+
+void main(List<String> args) {
+  var n = args.isEmpty ? 10000000 : int.parse(args[0]);
+  var random = Random(33);
+  var hoje = diaDeDateTime(DateTime.now());
+  var fatores = Int32List(n);
+  var pagamentos = Int32List(n);
+  for (var i = 0; i < n; i++) {
+    fatores[i] = 1000 + random.nextInt(9000);
+    pagamentos[i] = hoje - 400 + random.nextInt(800);
+  }
+  // Builds the tables outside the timed loops.
+  dataDoDia(hoje);
+
+  medir('table: factor -> yyyymmdd + payable without charges', () {
+    var soma = 0, pagaveis = 0;
+    for (var i = 0; i < n; i++) {
+      var vencimento = diaDoFator(fatores[i], hoje);
+      soma += dataDoDia(vencimento);
+      if (pagavelSemEncargos(vencimento, pagamentos[i])) pagaveis++;
+    }
+    return soma + pagaveis;
+  }, n);
+
+  var base = DateTime.utc(1997, 10, 7);
+  medir('DateTime: factor -> date + weekend check', () {
+    var soma = 0, pagaveis = 0;
+    for (var i = 0; i < n; i++) {
+      var vencimento = diaDoFator(fatores[i], hoje);
+      var data = base.add(Duration(days: vencimento));
+      soma += data.year * 10000 + data.month * 100 + data.day;
+      var util = data;
+      while (util.weekday > DateTime.friday) {
+        util = util.add(const Duration(days: 1));
+      }
+      if (pagamentos[i] <= util.difference(base).inDays) pagaveis++;
+    }
+    return soma + pagaveis;
+  }, n);
+}
@@ -0,0 +1,127 @@
+import 'dart:convert';
+
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+// Camera settings that differ from BarcodeCapture.recommendedCameraSettings; null keeps the recommended value.
+// Serialized as the JSON the app loads at startup from assets/camera_settings.json.
+class ConfiguracaoCamera {
+  final VideoResolution? resolucao;
+  final double? zoomFactor;
+  final FocusRange? focusRange;
+  final bool? smoothAutoFocus;
+
+  const ConfiguracaoCamera({this.resolucao, this.zoomFactor, this.focusRange, this.smoothAutoFocus});
+
+  void aplicarEm(CameraSettings settings) {
+    if (resolucao != null) settings.preferredResolution = resolucao!;
+    if (zoomFactor != null) settings.zoomFactor = zoomFactor!;
+    if (focusRange != null) settings.focusRange = focusRange!;
+    if (smoothAutoFocus != null) settings.shouldPreferSmoothAutoFocus = smoothAutoFocus!;
+  }
+
+  Map<String, dynamic> toJson() => {
+        if (resolucao != null) 'preferredResolution': _resolucoes[resolucao],
+        if (zoomFactor != null) 'zoomFactor': zoomFactor,
+        if (focusRange != null) 'focusRange': _focusRanges[focusRange],
+        if (smoothAutoFocus != null) 'shouldPreferSmoothAutoFocus': smoothAutoFocus,
+      };
+
+  factory ConfiguracaoCamera.fromJson(Map<String, dynamic> json) => ConfiguracaoCamera(
+      resolucao: _chavePara(_resolucoes, json['preferredResolution']),
+      zoomFactor: (json['zoomFactor'] as num?)?.toDouble(),
+      focusRange: _chavePara(_focusRanges, json['focusRange']),
+      smoothAutoFocus: json['shouldPreferSmoothAutoFocus'] as bool?);
+
+  @override
+  String toString() => jsonEncode(toJson());
+}
+
+const Map<VideoResolution, String> _resolucoes = {
+  VideoResolution.auto: 'auto',
+  VideoResolution.hd: 'hd',
+  VideoResolution.fullHd: 'fullHd',
+  VideoResolution.uhd4k: 'uhd4k',
+};
+
+const Map<FocusRange, String> _focusRanges = {
+  FocusRange.full: 'full',
+  FocusRange.near: 'near',
+  FocusRange.far: 'far',
+};
+
+T? _chavePara<T>(Map<T, String> nomes, Object? nome) {
+  for (var entry in nomes.entries) {
+    if (entry.value == nome) return entry.key;
+  }
+  return null;
+}
+
+// Every combination of the given values.
+List<ConfiguracaoCamera> gradeConfiguracoes(
+    {List<VideoResolution> resolucoes = const [VideoResolution.hd, VideoResolution.fullHd],
+    List<double> zooms = const [1.0, 1.5, 2.0],
+    List<FocusRange> focusRanges = const [FocusRange.full, FocusRange.near],
+    List<bool> smoothAutoFocus = const [false, true]}) {
+  return [
+    for (var resolucao in resolucoes)
+      for (var zoom in zooms)
+        for (var focusRange in focusRanges)
+          for (var smooth in smoothAutoFocus)
+            ConfiguracaoCamera(resolucao: resolucao, zoomFactor: zoom, focusRange: focusRange, smoothAutoFocus: smooth)
+  ];
+}
+
+// Outcome of replaying one recorded session under one configuration.
+class ResultadoSessao {
+  final bool decodificou;
+  final Duration tempoAteDecodificar;
+  final Duration cpu;
+
+  const ResultadoSessao(this.decodificou, this.tempoAteDecodificar, this.cpu);
+}
+
+// Replays recorded session `sessao` with `configuracao` applied. The replay itself (a frame source fed with the
+// recorded frames and a capture mode that reports the first decode) is platform specific and provided by the caller.
+typedef ExecutarSessao = Future<ResultadoSessao> Function(ConfiguracaoCamera configuracao, int sessao);
+
+class AvaliacaoConfiguracao {
+  final ConfiguracaoCamera configuracao;
+  final double taxaSucesso;
+
+  // Median over the sessions that decoded.
+  final Duration medianaTempoAteDecodificar;
+  final Duration mediaCpu;
+
+  AvaliacaoConfiguracao(this.configuracao, this.taxaSucesso, this.medianaTempoAteDecodificar, this.mediaCpu);
+}
+
+// Replays `sessoes` recorded sessions under every configuration and returns them ranked best first: higher success
+// rate, then lower median time to decode, then lower CPU time. Sessions run one at a time so that CPU measurements
+// do not interfere.
+Future<List<AvaliacaoConfiguracao>> ajustarCamera(
+    List<ConfiguracaoCamera> grade, int sessoes, ExecutarSessao executar) async {
+  var avaliacoes = <AvaliacaoConfiguracao>[];
+  for (var configuracao in grade) {
+    var tempos = <int>[];
+    var cpu = 0;
+    for (var sessao = 0; sessao < sessoes; sessao++) {
+      var resultado = await executar(configuracao, sessao);
+      if (resultado.decodificou) tempos.add(resultado.tempoAteDecodificar.inMicroseconds);
+      cpu += resultado.cpu.inMicroseconds;
+    }
+    tempos.sort();
+    avaliacoes.add(AvaliacaoConfiguracao(
+        configuracao,
+        sessoes == 0 ? 0 : tempos.length / sessoes,
+        Duration(microseconds: tempos.isEmpty ? 0 : tempos[tempos.length ~/ 2]),
+        Duration(microseconds: sessoes == 0 ? 0 : cpu ~/ sessoes)));
+  }
+  avaliacoes.sort((a, b) {
+    if (a.taxaSucesso != b.taxaSucesso) return b.taxaSucesso.compareTo(a.taxaSucesso);
+    if (a.medianaTempoAteDecodificar != b.medianaTempoAteDecodificar) {
+      return a.medianaTempoAteDecodificar.compareTo(b.medianaTempoAteDecodificar);
+    }
+    return a.mediaCpu.compareTo(b.mediaCpu);
+  });
+  return avaliacoes;
+}
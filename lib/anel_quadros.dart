@@ -0,0 +1,122 @@
+import 'dart:typed_data';
+
+// Fixed-capacity ring of luma (Y plane) buffers used to keep the frame that produced a boleto read around for audit.
+// Each slot is allocated the first time a frame is stored in it and reused from then on, so every incoming frame is a
+// plain row copy into the next free slot and the memory use stays at most capacity * maxWidth * maxHeight bytes for
+// as long as the lane runs. The default slot size holds a 4K (3840x2160) frame, the largest resolution the camera
+// tuner can pick (see ajuste_camera.dart).
+//
+// A slot is pinned once a scan references its frame id; pinned slots are skipped by the writer until released.
+//
+// The scanner screen pins the frame of every boleto it journals, but nothing feeds the ring yet: the capture plugin
+// does not hand camera frames to Dart, so it waits for a frame source (a native frame listener or a recorded
+// session) to push frames into it under their frameSequenceId.
+class AnelQuadrosLuma {
+  final int capacity;
+  final int maxWidth;
+  final int maxHeight;
+
+  final List<Uint8List?> _slots;
+  final List<int> _frameIds;
+  final List<int> _widths;
+  final List<int> _heights;
+  final List<bool> _pinned;
+  int _next = 0;
+  int _droppedFrames = 0;
+
+  AnelQuadrosLuma({this.capacity = 6, this.maxWidth = 3840, this.maxHeight = 2160})
+      : assert(capacity > 1),
+        _slots = List<Uint8List?>.filled(capacity, null),
+        _frameIds = List<int>.filled(capacity, -1),
+        _widths = List<int>.filled(capacity, 0),
+        _heights = List<int>.filled(capacity, 0),
+        _pinned = List<bool>.filled(capacity, false);
+
+  // Number of frames that could not be stored, either because they exceed the slot size or because every slot is
+  // pinned.
+  int get droppedFrames => _droppedFrames;
+
+  int get pinnedCount => _pinned.where((pinned) => pinned).length;
+
+  // Copies the luma plane of a frame into the next unpinned slot. `rowStride` is the distance in bytes between the
+  // start of two consecutive rows in `plane` and may be larger than `width` when the camera pads its rows.
+  bool put(int frameId, Uint8List plane, int width, int height, {int? rowStride, int offset = 0}) {
+    var stride = rowStride ?? width;
+    if (width > maxWidth || height > maxHeight || offset + stride * (height - 1) + width > plane.length) {
+      _droppedFrames++;
+      return false;
+    }
+
+    var slot = _nextFreeSlot();
+    if (slot < 0) {
+      _droppedFrames++;
+      return false;
+    }
+
+    var target = _slots[slot] ??= Uint8List(maxWidth * maxHeight);
+    if (stride == width) {
+      target.setRange(0, width * height, plane, offset);
+    } else {
+      for (var row = 0, src = offset, dst = 0; row < height; row++, src += stride, dst += width) {
+        target.setRange(dst, dst + width, plane, src);
+      }
+    }
+    _frameIds[slot] = frameId;
+    _widths[slot] = width;
+    _heights[slot] = height;
+    return true;
+  }
+
+  // Keeps the slot holding `frameId` from being overwritten. Returns false if the frame already left the ring.
+  bool pin(int frameId) {
+    var slot = _slotOf(frameId);
+    if (slot < 0) return false;
+    _pinned[slot] = true;
+    return true;
+  }
+
+  void release(int frameId) {
+    var slot = _slotOf(frameId);
+    if (slot >= 0) _pinned[slot] = false;
+  }
+
+  void releaseAll() {
+    _pinned.fillRange(0, capacity, false);
+  }
+
+  // Returns a view (no copy) over the stored luma plane of `frameId`, or null when the frame is no longer available.
+  // The view is only stable while the slot is pinned.
+  QuadroLuma? frame(int frameId) {
+    var slot = _slotOf(frameId);
+    if (slot < 0) return null;
+    var width = _widths[slot];
+    var height = _heights[slot];
+    return QuadroLuma(frameId, width, height, Uint8List.view(_slots[slot]!.buffer, 0, width * height));
+  }
+
+  int _nextFreeSlot() {
+    for (var i = 0; i < capacity; i++) {
+      var slot = _next;
+      _next = (_next + 1) % capacity;
+      if (!_pinned[slot]) return slot;
+    }
+    return -1;
+  }
+
+  int _slotOf(int frameId) {
+    if (frameId < 0) return -1;
+    for (var i = 0; i < capacity; i++) {
+      if (_frameIds[i] == frameId) return i;
+    }
+    return -1;
+  }
+}
+
+class QuadroLuma {
+  final int frameId;
+  final int width;
+  final int height;
+  final Uint8List data;
+
+  QuadroLuma(this.frameId, this.width, this.height, this.data);
+}
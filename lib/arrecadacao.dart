@@ -0,0 +1,69 @@
+import 'dart:typed_data';
+
+import 'boleto.dart';
+
+// Utility and tax bills ("arrecadação", FEBRABAN layout for collection documents). The barcode also has 44 digits
+// but starts with product "8", carries its general check digit in position 4 and, unlike bank boletos, picks the check
+// digit method per document through the value identifier in position 3: 6 and 7 use modulo 10, 8 and 9 modulo 11.
+// The digitable line has 48 digits, four blocks of 11 barcode digits each followed by its own check digit.
+class DadosArrecadacao {
+  final String barcode;
+  final String linha;
+  final bool isValid;
+
+  // Amount in cents, null when the value identifier says positions 5-15 hold a reference value instead (7 and 9).
+  final int? valorCentavos;
+
+  DadosArrecadacao(this.barcode, this.linha, this.isValid, this.valorCentavos);
+}
+
+DadosArrecadacao converterArrecadacao(String barra) {
+  var digits = barra.replaceAll(RegExp("[^0-9]"), "");
+  if (digits.length != 44 || digits.codeUnitAt(0) != 0x38) {
+    return DadosArrecadacao(digits, 'Não é um código de arrecadação', false, null);
+  }
+  var valores = Uint8List(44);
+  for (var i = 0; i < 44; i++) {
+    valores[i] = digits.codeUnitAt(i) - 0x30;
+  }
+  var identificador = valores[2];
+  if (identificador < 6) {
+    return DadosArrecadacao(digits, 'Identificador de valor inválido', false, null);
+  }
+
+  var linha = StringBuffer();
+  for (var bloco = 0; bloco < 4; bloco++) {
+    if (bloco > 0) linha.write(' ');
+    linha
+      ..write(digits.substring(bloco * 11, bloco * 11 + 11))
+      ..write('-')
+      ..write(digitoArrecadacao(valores, bloco * 11, bloco * 11 + 11, identificador));
+  }
+
+  var valor = 0;
+  for (var i = 4; i < 15; i++) {
+    valor = valor * 10 + valores[i];
+  }
+  var efetivo = identificador == 6 || identificador == 8;
+  var isValid = digitoGeralArrecadacao(valores) == valores[3];
+  return DadosArrecadacao(digits, linha.toString(), isValid, efetivo ? valor : null);
+}
+
+// Check digit of digits[start, end) with the method of value identifier `identificador` (6 to 9).
+int digitoArrecadacao(List<int> digits, int start, int end, int identificador) {
+  if (identificador <= 7) return digitoModulo10(digits, start, end);
+  var digito = 11 - somaModulo11(digits, start, end) % 11;
+  return digito > 9 ? 0 : digito;
+}
+
+// General check digit of a 44-digit arrecadação barcode, computed over every digit except position 4 (index 3).
+int digitoGeralArrecadacao(List<int> barcode) {
+  if (barcode[2] <= 7) {
+    // 40 digits to the right of the gap keep the modulo 10 weights in step, so both ranges start with weight 2.
+    var digito = 10 - (somaModulo10(barcode, 4, 44) + somaModulo10(barcode, 0, 3)) % 10;
+    return digito == 10 ? 0 : digito;
+  }
+  var soma = somaModulo11(barcode, 4, 44) + somaModulo11Continuacao(barcode, 0, 3, 40);
+  var digito = 11 - soma % 11;
+  return digito > 9 ? 0 : digito;
+}
@@ -0,0 +1,86 @@
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode_capture.dart';
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+// Helps with boletos that are too small or too far away to decode. While a barcode keeps being localized without
+// being decoded, the point of interest is moved onto it and the zoom factor is stepped up, one step every
+// `tempoNecessario`. A decode, or `tempoParaRestaurar` with nothing localized, restores the normal framing. Both are
+// durations rather than frame counts since the sessions reach the assist rate-limited (see LimitadorSessao).
+//
+// The point of interest is set on the view; the capture mode uses it as long as it has none of its own.
+class AssistenciaZoom {
+  final Camera camera;
+  final DataCaptureView view;
+  final CameraSettings settings;
+
+  // Time a barcode must stay localized-only before each step.
+  final Duration tempoNecessario;
+
+  // Time with nothing localized before the framing is restored.
+  final Duration tempoParaRestaurar;
+
+  // Zoom factors relative to the one in use when the assist starts, starting with 1.
+  final List<double> passos;
+
+  final PointWithUnit _pointOfInterestOriginal;
+  final Stopwatch _relogio = Stopwatch()..start();
+
+  // Start, in microseconds on _relogio, of the current run of frames with a barcode localized or with nothing
+  // localized; -1 outside such a run.
+  int _localizadoDesde = -1;
+  int _vazioDesde = -1;
+  int _passo = 0;
+  double _zoomBase = 1;
+  bool _ativa = false;
+  bool _aplicando = false;
+
+  AssistenciaZoom(this.camera, this.view, this.settings,
+      {this.tempoNecessario = const Duration(milliseconds: 330),
+      this.tempoParaRestaurar = const Duration(milliseconds: 1500),
+      this.passos = const [1.0, 1.6, 2.4]})
+      : _pointOfInterestOriginal = view.pointOfInterest;
+
+  // Called from didUpdateSession with the barcodes localized but not decoded in the frame.
+  void atualizar(List<LocalizedOnlyBarcode> localizados) {
+    var agora = _relogio.elapsedMicroseconds;
+    if (localizados.isEmpty) {
+      _localizadoDesde = -1;
+      if (_vazioDesde < 0) _vazioDesde = agora;
+      if (_ativa && agora - _vazioDesde >= tempoParaRestaurar.inMicroseconds) restaurar();
+      return;
+    }
+    _vazioDesde = -1;
+    if (_localizadoDesde < 0) _localizadoDesde = agora;
+    if (agora - _localizadoDesde < tempoNecessario.inMicroseconds || _aplicando) return;
+    _localizadoDesde = agora;
+    _aplicando = true;
+    _aproximar(localizados.first.location).whenComplete(() => _aplicando = false);
+  }
+
+  Future<void> _aproximar(Quadrilateral location) async {
+    var q = await view.viewQuadrilateralForFrameQuadrilateral(location);
+    var x = (q.topLeft.x + q.topRight.x + q.bottomRight.x + q.bottomLeft.x) / 4;
+    var y = (q.topLeft.y + q.topRight.y + q.bottomRight.y + q.bottomLeft.y) / 4;
+    view.pointOfInterest = PointWithUnit(DoubleWithUnit(x, MeasureUnit.dip), DoubleWithUnit(y, MeasureUnit.dip));
+    _ativa = true;
+    if (_passo + 1 < passos.length) {
+      if (_passo == 0) _zoomBase = settings.zoomFactor;
+      _passo++;
+      settings.zoomFactor = _zoomBase * passos[_passo];
+      await camera.applySettings(settings);
+    }
+  }
+
+  // Back to the centered point of interest and the normal zoom factor.
+  Future<void> restaurar() async {
+    _localizadoDesde = -1;
+    _vazioDesde = -1;
+    if (!_ativa) return;
+    _ativa = false;
+    view.pointOfInterest = _pointOfInterestOriginal;
+    if (_passo != 0) {
+      _passo = 0;
+      settings.zoomFactor = _zoomBase;
+      await camera.applySettings(settings);
+    }
+  }
+}
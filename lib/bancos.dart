@@ -0,0 +1,67 @@
+import 'dart:typed_data';
+
+// FEBRABAN bank registry. The first three digits of a boleto barcode are the issuing bank's compensation code; the
+// table below maps it to the bank's ISPB and names. Lookups go through a direct-indexed table over the 1000-code
+// space, built on the first lookup, so resolving the bank on the didScan path is a single array read.
+class Banco {
+  final int codigo;
+  final String ispb;
+  final String nomeCurto;
+  final String nome;
+
+  const Banco(this.codigo, this.ispb, this.nomeCurto, this.nome);
+
+  String get codigoFormatado => codigo.toString().padLeft(3, '0');
+}
+
+const List<Banco> bancos = [
+  Banco(1, '00000000', 'Banco do Brasil', 'Banco do Brasil S.A.'),
+  Banco(3, '04902979', 'Banco da Amazônia', 'Banco da Amazônia S.A.'),
+  Banco(4, '07237373', 'Banco do Nordeste', 'Banco do Nordeste do Brasil S.A.'),
+  Banco(21, '28127603', 'Banestes', 'Banestes S.A. Banco do Estado do Espírito Santo'),
+  Banco(33, '90400888', 'Santander', 'Banco Santander (Brasil) S.A.'),
+  Banco(37, '04913711', 'Banpará', 'Banco do Estado do Pará S.A.'),
+  Banco(41, '92702067', 'Banrisul', 'Banco do Estado do Rio Grande do Sul S.A.'),
+  Banco(47, '13009717', 'Banese', 'Banco do Estado de Sergipe S.A.'),
+  Banco(70, '00000208', 'BRB', 'BRB - Banco de Brasília S.A.'),
+  Banco(77, '00416968', 'Inter', 'Banco Inter S.A.'),
+  Banco(85, '05463212', 'Ailos', 'Cooperativa Central de Crédito - Ailos'),
+  Banco(104, '00360305', 'Caixa', 'Caixa Econômica Federal'),
+  Banco(136, '00315557', 'Unicred', 'Confederação Nacional das Cooperativas Centrais Unicred Ltda.'),
+  Banco(208, '30306294', 'BTG Pactual', 'Banco BTG Pactual S.A.'),
+  Banco(212, '92894922', 'Original', 'Banco Original S.A.'),
+  Banco(237, '60746948', 'Bradesco', 'Banco Bradesco S.A.'),
+  Banco(246, '28195667', 'ABC Brasil', 'Banco ABC Brasil S.A.'),
+  Banco(260, '18236120', 'Nubank', 'Nu Pagamentos S.A.'),
+  Banco(290, '08561701', 'PagSeguro', 'PagSeguro Internet S.A.'),
+  Banco(318, '61186680', 'BMG', 'Banco BMG S.A.'),
+  Banco(323, '10573521', 'Mercado Pago', 'Mercado Pago Instituição de Pagamento Ltda.'),
+  Banco(336, '31872495', 'C6 Bank', 'Banco C6 S.A.'),
+  Banco(341, '60701190', 'Itaú', 'Itaú Unibanco S.A.'),
+  Banco(380, '22896431', 'PicPay', 'PicPay Serviços S.A.'),
+  Banco(389, '17184037', 'Mercantil do Brasil', 'Banco Mercantil do Brasil S.A.'),
+  Banco(422, '58160789', 'Safra', 'Banco Safra S.A.'),
+  Banco(604, '31895683', 'Industrial do Brasil', 'Banco Industrial do Brasil S.A.'),
+  Banco(623, '59285411', 'Pan', 'Banco Pan S.A.'),
+  Banco(634, '17351180', 'Triângulo', 'Banco Triângulo S.A.'),
+  Banco(655, '59588111', 'Votorantim', 'Banco Votorantim S.A.'),
+  Banco(707, '62232889', 'Daycoval', 'Banco Daycoval S.A.'),
+  Banco(745, '33479023', 'Citibank', 'Banco Citibank S.A.'),
+  Banco(748, '01181521', 'Sicredi', 'Banco Cooperativo Sicredi S.A.'),
+  Banco(756, '02038232', 'Sicoob', 'Banco Cooperativo do Brasil S.A. - Bancoob'),
+];
+
+// Position + 1 of each code's entry in `bancos`, 0 for codes without an entry.
+final Uint8List _indice = () {
+  var indice = Uint8List(1000);
+  for (var i = 0; i < bancos.length; i++) {
+    indice[bancos[i].codigo] = i + 1;
+  }
+  return indice;
+}();
+
+Banco? bancoPorCodigo(int codigo) {
+  if (codigo < 0 || codigo > 999) return null;
+  var posicao = _indice[codigo];
+  return posicao == 0 ? null : bancos[posicao - 1];
+}
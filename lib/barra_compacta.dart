@@ -0,0 +1,255 @@
+import 'dart:typed_data';
+
+import 'boleto.dart';
+
+// 44-digit boleto barcode packed into three integers: digits 1-18, 19-36 and 37-44 as plain decimal numbers. Every
+// word stays below 10^18, so the words are non-negative, equality and hashing are three integer operations and
+// ordering word by word matches the ordering of the digit strings.
+class BarraCompacta implements Comparable<BarraCompacta> {
+  static const int length = 44;
+
+  final int hi;
+  final int mid;
+  final int lo;
+
+  const BarraCompacta(this.hi, this.mid, this.lo);
+
+  // Packs the ASCII digits bytes[offset, offset + 44), e.g. the raw bytes of a scanned barcode. Returns null if any of
+  // them is not a digit.
+  static BarraCompacta? fromBytes(List<int> bytes, [int offset = 0]) {
+    if (bytes.length - offset < length) return null;
+    var hi = _word(bytes, offset, offset + 18);
+    var mid = _word(bytes, offset + 18, offset + 36);
+    var lo = _word(bytes, offset + 36, offset + 44);
+    if (hi < 0 || mid < 0 || lo < 0) return null;
+    return BarraCompacta(hi, mid, lo);
+  }
+
+  static BarraCompacta? tryParse(String barcode) => barcode.length == length ? fromBytes(barcode.codeUnits) : null;
+
+  static BarraCompacta? fromDigits(List<int> digits) {
+    if (digits.length != length) return null;
+    var hi = 0, mid = 0, lo = 0;
+    for (var i = 0; i < 18; i++) {
+      hi = hi * 10 + digits[i];
+      mid = mid * 10 + digits[i + 18];
+    }
+    for (var i = 36; i < 44; i++) {
+      lo = lo * 10 + digits[i];
+    }
+    return BarraCompacta(hi, mid, lo);
+  }
+
+  static int _word(List<int> bytes, int start, int end) {
+    var value = 0;
+    for (var i = start; i < end; i++) {
+      var digit = bytes[i] - 0x30;
+      if (digit < 0 || digit > 9) return -1;
+      value = value * 10 + digit;
+    }
+    return value;
+  }
+
+  // Bank code, positions 1-3.
+  int get banco => hi ~/ 1000000000000000;
+
+  // Due date factor, positions 6-9; 0 when the boleto has no due date.
+  int get fatorVencimento => hi ~/ 1000000000 % 10000;
+
+  // Amount in cents, positions 10-19.
+  int get valorCentavos => hi % 1000000000 * 10 + mid ~/ 100000000000000000;
+
+  int digitAt(int index) {
+    if (index < 18) return hi ~/ _pow10[17 - index] % 10;
+    if (index < 36) return mid ~/ _pow10[35 - index] % 10;
+    return lo ~/ _pow10[43 - index] % 10;
+  }
+
+  // Unpacks the 44 digits into `out`, which must hold at least 44 elements.
+  Uint8List digitsInto(Uint8List out) {
+    _unpack(hi, out, 0, 18);
+    _unpack(mid, out, 18, 18);
+    _unpack(lo, out, 36, 8);
+    return out;
+  }
+
+  static void _unpack(int word, Uint8List out, int start, int count) {
+    for (var i = start + count - 1; i >= start; i--) {
+      out[i] = word % 10;
+      word ~/= 10;
+    }
+  }
+
+  bool get hasValidDv {
+    var digits = digitsInto(_scratch);
+    return digits[4] == digitoModulo11Banco(digits);
+  }
+
+  // Renders the digitable line exactly as calculaLinha does, straight from the packed words.
+  String toLinhaDigitavel() {
+    var digits = digitsInto(_scratch);
+    if (digits[4] != digitoModulo11Banco(digits)) {
+      // Rare path: reuse calculaLinha's error message.
+      return calculaLinha(toString());
+    }
+    return formatarLinhaDigitavel(linhaDigitsInto(_linhaScratch));
+  }
+
+  // Writes the 47 digits of the digitable line into `linha`, which must hold at least 47 elements. The general check
+  // digit is copied as is, so this also works for a barcode whose check digit does not match.
+  Uint8List linhaDigitsInto(Uint8List linha) {
+    var digits = digitsInto(_scratch);
+    for (var i = 0; i < 4; i++) {
+      linha[i] = digits[i];
+    }
+    for (var i = 0; i < 5; i++) {
+      linha[4 + i] = digits[19 + i];
+    }
+    linha[9] = digitoModulo10(linha, 0, 9);
+    for (var i = 0; i < 10; i++) {
+      linha[10 + i] = digits[24 + i];
+      linha[21 + i] = digits[34 + i];
+    }
+    linha[20] = digitoModulo10(linha, 10, 20);
+    linha[31] = digitoModulo10(linha, 21, 31);
+    linha[32] = digits[4];
+    for (var i = 0; i < 14; i++) {
+      linha[33 + i] = digits[5 + i];
+    }
+    return linha;
+  }
+
+  @override
+  bool operator ==(Object other) => other is BarraCompacta && other.hi == hi && other.mid == mid && other.lo == lo;
+
+  @override
+  int get hashCode => hashWords(hi, mid, lo);
+
+  @override
+  int compareTo(BarraCompacta other) {
+    if (hi != other.hi) return hi < other.hi ? -1 : 1;
+    if (mid != other.mid) return mid < other.mid ? -1 : 1;
+    if (lo != other.lo) return lo < other.lo ? -1 : 1;
+    return 0;
+  }
+
+  @override
+  String toString() => String.fromCharCodes(digitsInto(_scratch).map((digit) => digit + 0x30));
+
+  static int hashWords(int hi, int mid, int lo) {
+    var hash = (hi * 0x9e3779b1 + mid) * 0x9e3779b1 + lo;
+    return (hash ^ (hash >> 29)) & 0x3fffffff;
+  }
+
+  static final Uint8List _scratch = Uint8List(length);
+  static final Uint8List _linhaScratch = Uint8List(47);
+}
+
+// Formats the 47 digits of a digitable line as "AAAAA.AAAAA BBBBB.BBBBBB CCCCC.CCCCCC D EEEEEEEEEEEEEE".
+String formatarLinhaDigitavel(List<int> linha) {
+  var chars = Uint8List(54);
+  var o = 0;
+  for (var i = 0; i < 47; i++) {
+    if (i == 5 || i == 15 || i == 26) chars[o++] = 0x2e; // '.'
+    if (i == 10 || i == 21 || i == 32 || i == 33) chars[o++] = 0x20; // ' '
+    chars[o++] = linha[i] + 0x30;
+  }
+  return String.fromCharCodes(chars);
+}
+
+const List<int> _pow10 = [
+  1,
+  10,
+  100,
+  1000,
+  10000,
+  100000,
+  1000000,
+  10000000,
+  100000000,
+  1000000000,
+  10000000000,
+  100000000000,
+  1000000000000,
+  10000000000000,
+  100000000000000,
+  1000000000000000,
+  10000000000000000,
+  100000000000000000,
+];
+
+// Open addressing hash set of packed barcodes stored column-wise in three Int64Lists, i.e. 24 bytes per slot and no
+// per-code object, for sets of millions of barcodes.
+class ConjuntoBarras {
+  static const int _empty = -1;
+
+  Int64List _hi;
+  Int64List _mid;
+  Int64List _lo;
+  int _length = 0;
+
+  ConjuntoBarras([int expected = 16])
+      : _hi = Int64List(_capacityFor(expected))..fillRange(0, _capacityFor(expected), _empty),
+        _mid = Int64List(_capacityFor(expected)),
+        _lo = Int64List(_capacityFor(expected));
+
+  int get length => _length;
+
+  static int _capacityFor(int expected) {
+    var capacity = 16;
+    while (capacity * 3 < expected * 4) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  bool contains(BarraCompacta code) => _hi[_find(code.hi, code.mid, code.lo)] != _empty;
+
+  // Returns true if `code` was not yet in the set.
+  bool add(BarraCompacta code) {
+    var slot = _find(code.hi, code.mid, code.lo);
+    if (_hi[slot] != _empty) return false;
+    _hi[slot] = code.hi;
+    _mid[slot] = code.mid;
+    _lo[slot] = code.lo;
+    if (++_length * 4 > _hi.length * 3) _grow();
+    return true;
+  }
+
+  void clear() {
+    _hi.fillRange(0, _hi.length, _empty);
+    _length = 0;
+  }
+
+  Iterable<BarraCompacta> get values sync* {
+    for (var i = 0; i < _hi.length; i++) {
+      if (_hi[i] != _empty) yield BarraCompacta(_hi[i], _mid[i], _lo[i]);
+    }
+  }
+
+  // Linear probing; returns the slot holding the code or the empty slot where it belongs.
+  int _find(int hi, int mid, int lo) {
+    var mask = _hi.length - 1;
+    var slot = BarraCompacta.hashWords(hi, mid, lo) & mask;
+    while (_hi[slot] != _empty && (_hi[slot] != hi || _mid[slot] != mid || _lo[slot] != lo)) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void _grow() {
+    var hi = _hi, mid = _mid, lo = _lo;
+    var capacity = hi.length * 2;
+    _hi = Int64List(capacity)..fillRange(0, capacity, _empty);
+    _mid = Int64List(capacity);
+    _lo = Int64List(capacity);
+    for (var i = 0; i < hi.length; i++) {
+      if (hi[i] != _empty) {
+        var slot = _find(hi[i], mid[i], lo[i]);
+        _hi[slot] = hi[i];
+        _mid[slot] = mid[i];
+        _lo[slot] = lo[i];
+      }
+    }
+  }
+}
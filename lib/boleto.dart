@@ -0,0 +1,184 @@
+import 'dart:typed_data';
+
+import 'bancos.dart';
+import 'barra_compacta.dart';
+import 'campo_livre.dart';
+import 'vencimento.dart';
+
+//Configure functions to parse the Boleto -- https://bit.ly/3zct7Yn
+//-------------------------------------------------------------------
+String modulo10(String numero)  {
+  numero = numero.replaceAll(RegExp("[^0-9]"),"");
+  double soma  = 0;
+  double peso  = 2;
+  int contador = numero.length-1;
+  while (contador >= 0) {
+    double multiplicacao = (double.parse(numero.substring(contador,contador+1)) * peso);
+    if (multiplicacao >= 10) {multiplicacao = 1 + (multiplicacao-10);}
+    soma = soma + multiplicacao;
+    if (peso == 2) {
+      peso = 1;
+    } else {
+      peso = 2;
+    }
+    contador = contador - 1;
+  }
+  double digito = 10 - (soma % 10);
+  if (digito == 10) digito = 0;
+
+  return digito.round().toString();
+}
+
+String modulo11Banco(String numero) {
+  numero = numero.replaceAll(RegExp("[^0-9]"),"");
+
+  double soma  = 0;
+  double peso  = 2;
+  double base  = 9;
+  int contador = numero.length - 1;
+  for (int i=contador; i >= 0; i--) {
+    soma = soma +  (double.parse(numero.substring(i,i+1)) * peso);
+    if (peso < base) {
+      peso++;
+    } else {
+      peso = 2;
+    }
+  }
+  num digito = 11 - (soma % 11);
+  if (digito >  9) digito = 0;
+  /* Utilizar o dígito 1(um) sempre que o resultado do cálculo padrão for igual a 0(zero), 1(um) ou 10(dez). */
+  if (digito == 0) digito = 1;
+  return digito.toString();
+}
+
+String calculaLinha(String barra)  {
+  String linha = barra.replaceAll("[^0-9]", "");
+
+  if (linha.length != 44) {
+    return ("A linha do Código de Barras está incompleta!"); // Error
+  }
+
+  String campo1 = linha.substring(0,4)+linha.substring(19,20)+'.'+linha.substring(20,24);
+  String campo2 = linha.substring(24,29)+'.'+linha.substring(29,34);
+  String campo3 = linha.substring(34,39)+'.'+linha.substring(39,44);
+  String campo4 = linha.substring(4,5); // Digito verificador
+  String campo5 = linha.substring(5,19); // Vencimento + Valor
+
+  var digito = modulo11Banco(  linha.substring(0,4)+linha.substring(5,44));
+  var digitoValAr = digito.split('.');
+
+  if (  digitoValAr[0] != campo4 ) {
+    return ("Digito verificador "+campo4+", o correto é "+digitoValAr[0]+"\nO sistema não altera automaticamente o dígito correto na quinta casa!"); //Error
+  }
+
+  return   campo1 + modulo10(campo1)
+      +' '
+      +campo2 + modulo10(campo2)
+      +' '
+      +campo3 + modulo10(campo3)
+      +' '
+      +campo4
+      +' '
+      +campo5
+  ;
+}
+
+
+// Decoded view of one scanned boleto: the 44-digit barcode and the digitable line produced by calculaLinha (or the
+// error message calculaLinha returned when the barcode is incomplete or its check digit does not match).
+class DadosBoleto {
+  final String barcode;
+  final String linha;
+  final bool isValid;
+
+  // Packed form of the barcode, null when it does not have 44 digits.
+  final BarraCompacta? packed;
+
+  DadosBoleto(this.barcode, this.linha, this.isValid, [this.packed]);
+
+  // Issuing bank, from the compensation code in positions 1-3.
+  Banco? get banco => packed == null ? null : bancoPorCodigo(packed!.banco);
+
+  // Due day (see vencimento.dart) resolved against `hoje`, or -1 when the boleto has no due date.
+  int diaVencimento(int hoje) => packed == null ? -1 : diaDoFator(packed!.fatorVencimento, hoje);
+
+  int get valorCentavos => packed?.valorCentavos ?? 0;
+
+  // Bank-specific free field, null for banks without a parser.
+  CampoLivre? get campoLivre =>
+      packed == null ? null : lerCampoLivre(packed!.digitsInto(Uint8List(BarraCompacta.length)));
+}
+
+DadosBoleto converterBoleto(String barra) {
+  // Scanned values are normally exactly 44 digits and take the packed path without any intermediate strings.
+  var digits = barra;
+  var packed = BarraCompacta.tryParse(digits);
+  if (packed == null) {
+    digits = barra.replaceAll(RegExp("[^0-9]"), "");
+    packed = BarraCompacta.tryParse(digits);
+  }
+  if (packed == null) {
+    return DadosBoleto(digits, calculaLinha(digits), false);
+  }
+  return DadosBoleto(digits, packed.toLinhaDigitavel(), packed.hasValidDv, packed);
+}
+
+// Integer check digit kernels over digit arrays (values 0-9). They follow modulo10 and modulo11Banco but work on
+// ranges of an already decoded digit array, so hot paths do not need substrings or double arithmetic.
+int somaModulo10(List<int> digits, int start, int end) {
+  var soma = 0;
+  var peso = 2;
+  for (var i = end - 1; i >= start; i--) {
+    var multiplicacao = digits[i] * peso;
+    soma += multiplicacao >= 10 ? multiplicacao - 9 : multiplicacao;
+    peso = 3 - peso;
+  }
+  return soma;
+}
+
+int digitoModulo10(List<int> digits, int start, int end) {
+  var digito = 10 - somaModulo10(digits, start, end) % 10;
+  return digito == 10 ? 0 : digito;
+}
+
+// Weighted sum with weights 2..pesoMaximo repeating from the rightmost digit.
+int somaModulo11(List<int> digits, int start, int end, [int pesoMaximo = 9]) {
+  var soma = 0;
+  var peso = 2;
+  for (var i = end - 1; i >= start; i--) {
+    soma += digits[i] * peso;
+    peso = peso < pesoMaximo ? peso + 1 : 2;
+  }
+  return soma;
+}
+
+// General check digit of a 44-digit barcode, computed over every digit except position 5 (index 4).
+int digitoModulo11Banco(List<int> barcode) {
+  var soma = somaModulo11(barcode, 5, 44) + somaModulo11Continuacao(barcode, 0, 4, 39);
+  var digito = 11 - soma % 11;
+  if (digito > 9) digito = 0;
+  return digito == 0 ? 1 : digito;
+}
+
+// Weighted modulo 11 sum of digits[start, end) when `skipped` digits to the right were already summed, so the weight
+// sequence continues where the previous range stopped.
+int somaModulo11Continuacao(List<int> digits, int start, int end, int skipped, [int pesoMaximo = 9]) {
+  var soma = 0;
+  var peso = 2 + skipped % (pesoMaximo - 1);
+  for (var i = end - 1; i >= start; i--) {
+    soma += digits[i] * peso;
+    peso = peso < pesoMaximo ? peso + 1 : 2;
+  }
+  return soma;
+}
+
+// Formats an amount in cents as "R$ 1.234,56".
+String formatarValor(int centavos) {
+  var reais = (centavos ~/ 100).toString();
+  var milhares = StringBuffer();
+  for (var i = 0; i < reais.length; i++) {
+    if (i > 0 && (reais.length - i) % 3 == 0) milhares.write('.');
+    milhares.write(reais[i]);
+  }
+  return 'R\$ $milhares,${(centavos % 100).toString().padLeft(2, '0')}';
+}
@@ -0,0 +1,177 @@
+import 'dart:typed_data';
+
+import 'diario_leituras.dart';
+
+// Fuzzy search over the digitable lines in the journal, for fragments read out loud with a digit wrong, missing or
+// extra. Every line is split into its 44 overlapping 4-digit grams; each of the 10^4 grams keeps the ids of the lines
+// containing it as a posting list of delta-encoded varints, which stays at one or two bytes per posting since ids
+// only grow. A fragment with g distinct grams shares at least g - 4k of them with a line it matches with k edits, so
+// counting shared grams over the fragment's posting lists yields a short candidate list, and only those are checked
+// with the bit-parallel edit distance. New journal entries are indexed on the next query.
+class IndiceNGram {
+  static const int _grams = 10000;
+
+  final DiarioLeituras journal;
+
+  final List<Uint8List?> _postings = List<Uint8List?>.filled(_grams, null);
+  final Int32List _tamanhos = Int32List(_grams);
+  final Int32List _ultimos = Int32List(_grams)..fillRange(0, _grams, -1);
+  int _indexados = 0;
+
+  final Uint8List _linha = Uint8List(47);
+  Uint8List _contagens = Uint8List(1024);
+
+  IndiceNGram(this.journal);
+
+  // Indexes the journal entries added since the last call.
+  void atualizar() {
+    for (; _indexados < journal.length; _indexados++) {
+      var id = _indexados;
+      journal.barcodeAt(id).linhaDigitsInto(_linha);
+      var gram = _linha[0] * 100 + _linha[1] * 10 + _linha[2];
+      for (var i = 3; i < 47; i++) {
+        gram = gram % 1000 * 10 + _linha[i];
+        // A gram repeated within the line is posted once.
+        if (_ultimos[gram] == id) continue;
+        _postar(gram, id - _ultimos[gram]);
+        _ultimos[gram] = id;
+      }
+    }
+  }
+
+  void _postar(int gram, int delta) {
+    var bytes = _postings[gram];
+    var tamanho = _tamanhos[gram];
+    if (bytes == null || tamanho + 5 > bytes.length) {
+      var maior = Uint8List(bytes == null ? 8 : bytes.length * 2);
+      if (bytes != null) maior.setRange(0, tamanho, bytes);
+      _postings[gram] = bytes = maior;
+    }
+    while (delta >= 0x80) {
+      bytes[tamanho++] = (delta & 0x7f) | 0x80;
+      delta >>= 7;
+    }
+    bytes[tamanho++] = delta;
+    _tamanhos[gram] = tamanho;
+  }
+
+  // Journal entries whose line contains the digits of `consulta` (other characters are ignored) with at most
+  // `maxErros` edits, best first and newest first among equals, at most `limite` of them.
+  List<ResultadoBusca> buscar(String consulta, {int maxErros = 1, int limite = 50}) {
+    atualizar();
+    var padrao = <int>[
+      for (var unit in consulta.codeUnits)
+        if (unit >= 0x30 && unit <= 0x39) unit - 0x30
+    ];
+    var m = padrao.length;
+    if (m == 0 || m > 47) return const [];
+    var matcher = _Myers(padrao);
+
+    var resultado = <ResultadoBusca>[];
+    void verificar(int id) {
+      journal.barcodeAt(id).linhaDigitsInto(_linha);
+      var distancia = matcher.distancia(_linha);
+      if (distancia <= maxErros) resultado.add(ResultadoBusca(id, distancia));
+    }
+
+    var grams = <int>{};
+    for (var i = 3; i < m; i++) {
+      grams.add(padrao[i - 3] * 1000 + padrao[i - 2] * 100 + padrao[i - 1] * 10 + padrao[i]);
+    }
+    // Each edit breaks at most 4 of the fragment's grams.
+    var minimo = grams.length - 4 * maxErros;
+    if (minimo <= 0) {
+      // Too short for the gram filter to rule anything out.
+      for (var id = 0; id < _indexados; id++) {
+        verificar(id);
+      }
+    } else {
+      for (var id in _candidatos(grams, minimo)) {
+        verificar(id);
+      }
+    }
+
+    resultado.sort((a, b) => a.distancia != b.distancia ? a.distancia - b.distancia : b.indice - a.indice);
+    return resultado.length > limite ? resultado.sublist(0, limite) : resultado;
+  }
+
+  // Ids of the lines containing at least `minimo` of `grams`.
+  List<int> _candidatos(Set<int> grams, int minimo) {
+    if (_contagens.length < _indexados) _contagens = Uint8List(_indexados * 2);
+
+    var tocados = <int>[];
+    for (var gram in grams) {
+      var bytes = _postings[gram];
+      if (bytes == null) continue;
+      var tamanho = _tamanhos[gram];
+      var id = -1;
+      var i = 0;
+      while (i < tamanho) {
+        var delta = 0, shift = 0, b = 0;
+        do {
+          b = bytes[i++];
+          delta |= (b & 0x7f) << shift;
+          shift += 7;
+        } while (b & 0x80 != 0);
+        id += delta;
+        if (_contagens[id]++ == 0) tocados.add(id);
+      }
+    }
+
+    var candidatos = <int>[];
+    for (var id in tocados) {
+      if (_contagens[id] >= minimo) candidatos.add(id);
+      _contagens[id] = 0;
+    }
+    return candidatos;
+  }
+}
+
+class ResultadoBusca {
+  final int indice;
+  final int distancia;
+
+  ResultadoBusca(this.indice, this.distancia);
+}
+
+// Myers' bit-parallel approximate matching: the smallest edit distance between the pattern and any substring of the
+// text, one column of the dynamic programming table per text digit in a handful of word operations. Patterns of up
+// to 47 digits fit in one 64-bit word.
+class _Myers {
+  final int m;
+  final int _mask;
+  final int _alto;
+  final Int64List _peq = Int64List(10);
+
+  _Myers(List<int> padrao)
+      : m = padrao.length,
+        _mask = (1 << padrao.length) - 1,
+        _alto = 1 << (padrao.length - 1) {
+    for (var i = 0; i < m; i++) {
+      _peq[padrao[i]] |= 1 << i;
+    }
+  }
+
+  int distancia(Uint8List texto) {
+    var pv = _mask, mv = 0, score = m, melhor = m;
+    for (var j = 0; j < texto.length; j++) {
+      var eq = _peq[texto[j]];
+      var xv = eq | mv;
+      var xh = ((((eq & pv) + pv) & _mask) ^ pv) | eq;
+      var ph = (mv | ~(xh | pv)) & _mask;
+      var mh = pv & xh;
+      if (ph & _alto != 0) {
+        score++;
+      } else if (mh & _alto != 0) {
+        score--;
+      }
+      // No carry into the first row: a match may start anywhere in the text.
+      ph = (ph << 1) & _mask;
+      mh = (mh << 1) & _mask;
+      pv = (mh | ~(xv | ph)) & _mask;
+      mv = ph & xv;
+      if (score < melhor) melhor = score;
+    }
+    return melhor;
+  }
+}
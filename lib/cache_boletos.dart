@@ -0,0 +1,83 @@
+import 'dart:collection';
+
+import 'boleto.dart';
+
+// Bounded, time-aware LRU of recently converted boletos. Customers often present the same boleto several times, well
+// outside the engine's duplicate filter window; a repeat is answered from the cache in O(1) without running
+// calculaLinha again and is reported as a duplicate.
+class CacheBoletos {
+  final int capacity;
+  final Duration maxAge;
+
+  // LinkedHashMap keeps insertion order, so re-inserting on every hit keeps the least recently seen entry first.
+  final LinkedHashMap<String, _EntradaCache> _entries = LinkedHashMap<String, _EntradaCache>();
+
+  int _hits = 0;
+  int _misses = 0;
+
+  CacheBoletos({this.capacity = 512, this.maxAge = const Duration(hours: 8)}) : assert(capacity > 0);
+
+  int get hits => _hits;
+
+  int get misses => _misses;
+
+  // Share of lookups answered from the cache, logged by the scanner screen in debug builds.
+  double get hitRate => _hits + _misses == 0 ? 0 : _hits / (_hits + _misses);
+
+  int get length => _entries.length;
+
+  ConsultaBoleto converter(String barra, {DateTime? now}) {
+    var time = now ?? DateTime.now();
+    var entry = _entries.remove(barra);
+    if (entry != null && time.difference(entry.convertedAt) <= maxAge) {
+      _hits++;
+      var sinceLastSeen = time.difference(entry.lastSeenAt);
+      entry.lastSeenAt = time;
+      _entries[barra] = entry;
+      return ConsultaBoleto(entry.boleto, true, sinceLastSeen);
+    }
+
+    _misses++;
+    var boleto = converterBoleto(barra);
+    _entries[barra] = _EntradaCache(boleto, time);
+    if (_entries.length > capacity) {
+      _entries.remove(_entries.keys.first);
+    }
+    return ConsultaBoleto(boleto, false, Duration.zero);
+  }
+
+  // Batch counterpart of converter() for all barcodes of a capture session; a barcode repeated inside the batch is
+  // only looked up once.
+  List<ConsultaBoleto> converterTodos(Iterable<String> barras, {DateTime? now}) {
+    var time = now ?? DateTime.now();
+    var seen = <String>{};
+    return [
+      for (var barra in barras)
+        if (seen.add(barra)) converter(barra, now: time)
+    ];
+  }
+
+  void clear() {
+    _entries.clear();
+    _hits = 0;
+    _misses = 0;
+  }
+}
+
+class ConsultaBoleto {
+  final DadosBoleto boleto;
+  final bool isDuplicate;
+
+  // Time since the boleto was last seen, zero for a boleto seen for the first time.
+  final Duration sinceLastSeen;
+
+  ConsultaBoleto(this.boleto, this.isDuplicate, this.sinceLastSeen);
+}
+
+class _EntradaCache {
+  final DadosBoleto boleto;
+  final DateTime convertedAt;
+  DateTime lastSeenAt;
+
+  _EntradaCache(this.boleto, this.convertedAt) : lastSeenAt = convertedAt;
+}
@@ -0,0 +1,128 @@
+import 'dart:typed_data';
+
+import 'boleto.dart';
+
+// Bank-specific free field ("campo livre", barcode positions 20-44). Fields a bank's layout does not carry are null.
+class CampoLivre {
+  final String? nossoNumero;
+  final String? agencia;
+  final String? conta;
+  final String? carteira;
+  final String? beneficiario;
+
+  // False when one of the check digits embedded in the free field does not match.
+  final bool digitosValidos;
+
+  CampoLivre(
+      {this.nossoNumero, this.agencia, this.conta, this.carteira, this.beneficiario, this.digitosValidos = true});
+}
+
+typedef LeitorCampoLivre = CampoLivre Function(Uint8List barcode);
+
+// Parsers indexed directly by bank compensation code.
+final List<LeitorCampoLivre?> _parsers = List<LeitorCampoLivre?>.filled(1000, null)
+  ..[1] = _bancoDoBrasil
+  ..[33] = _santander
+  ..[104] = _caixa
+  ..[237] = _bradesco
+  ..[341] = _itau;
+
+// Parses the free field of a 44-digit barcode given as digit values. Returns null for banks without a parser.
+CampoLivre? lerCampoLivre(Uint8List barcode) {
+  var parser = _parsers[barcode[0] * 100 + barcode[1] * 10 + barcode[2]];
+  return parser == null ? null : parser(barcode);
+}
+
+// Barcode positions are 1-based in the bank manuals; `_campo(barcode, 20, 23)` returns positions 20 through 23.
+String _campo(Uint8List barcode, int from, int to) =>
+    String.fromCharCodes(barcode.getRange(from - 1, to).map((digit) => digit + 0x30));
+
+int _digito(Uint8List barcode, int position) => barcode[position - 1];
+
+// Modulo 11 with weights 2-9, where remainders 0 and 1 give check digit 0.
+int _digitoModulo11(List<int> digits, int start, int end) {
+  var digito = 11 - somaModulo11(digits, start, end) % 11;
+  return digito > 9 ? 0 : digito;
+}
+
+// Banco do Brasil: 7-digit convênios start the free field with six zeros followed by a 17-digit nosso número and the
+// carteira. 4- and 6-digit convênios put convênio and nosso número in 11 digits, then agência, conta and carteira.
+CampoLivre _bancoDoBrasil(Uint8List barcode) {
+  var convenio7 = true;
+  for (var position = 20; position <= 25; position++) {
+    if (_digito(barcode, position) != 0) convenio7 = false;
+  }
+  if (convenio7) {
+    return CampoLivre(
+        beneficiario: _campo(barcode, 26, 32), nossoNumero: _campo(barcode, 26, 42), carteira: _campo(barcode, 43, 44));
+  }
+  return CampoLivre(
+      nossoNumero: _campo(barcode, 20, 30),
+      agencia: _campo(barcode, 31, 34),
+      conta: _campo(barcode, 35, 42),
+      carteira: _campo(barcode, 43, 44));
+}
+
+// Santander: fixed 9, código do beneficiário (7), nosso número with its modulo 11 check digit (13), IOF, carteira.
+CampoLivre _santander(Uint8List barcode) {
+  var valid = _digito(barcode, 20) == 9 && _digitoModulo11(barcode, 27, 39) == _digito(barcode, 40);
+  return CampoLivre(
+      beneficiario: _campo(barcode, 21, 27),
+      nossoNumero: _campo(barcode, 28, 40),
+      carteira: _campo(barcode, 42, 44),
+      digitosValidos: valid);
+}
+
+// Caixa (SIGCB): beneficiário and its check digit, nosso número split in three sequences around the two constants
+// (modalidade and emissão), and a modulo 11 check digit over the whole free field.
+CampoLivre _caixa(Uint8List barcode) {
+  var valid = _digitoModulo11(barcode, 19, 25) == _digito(barcode, 26) &&
+      _digitoModulo11(barcode, 19, 43) == _digito(barcode, 44);
+  return CampoLivre(
+      beneficiario: _campo(barcode, 20, 25),
+      nossoNumero: _campo(barcode, 30, 30) +
+          _campo(barcode, 34, 34) +
+          _campo(barcode, 27, 29) +
+          _campo(barcode, 31, 33) +
+          _campo(barcode, 35, 43),
+      carteira: _campo(barcode, 30, 30),
+      digitosValidos: valid);
+}
+
+// Bradesco: agência, carteira, nosso número (11), conta (7) and a trailing zero. The nosso número check digit is not
+// part of the barcode.
+CampoLivre _bradesco(Uint8List barcode) {
+  return CampoLivre(
+      agencia: _campo(barcode, 20, 23),
+      carteira: _campo(barcode, 24, 25),
+      nossoNumero: _campo(barcode, 26, 36),
+      conta: _campo(barcode, 37, 43),
+      digitosValidos: _digito(barcode, 44) == 0);
+}
+
+// Itaú: carteira, nosso número and its modulo 10 DAC over agência/conta/carteira/nosso número, agência, conta and
+// its modulo 10 DAC over agência/conta, then three zeros. Carteiras 126, 131, 146, 150 and 168 compute the first DAC
+// over carteira and nosso número only.
+CampoLivre _itau(Uint8List barcode) {
+  var scratch = Uint8List(20);
+  var carteira = _digito(barcode, 20) * 100 + _digito(barcode, 21) * 10 + _digito(barcode, 22);
+  var length = 0;
+  if (!const [126, 131, 146, 150, 168].contains(carteira)) {
+    scratch.setRange(0, 4, barcode, 31); // agência, positions 32-35
+    scratch.setRange(4, 9, barcode, 35); // conta, positions 36-40
+    length = 9;
+  }
+  scratch.setRange(length, length + 11, barcode, 19); // carteira and nosso número, positions 20-30
+  length += 11;
+  var valid = digitoModulo10(scratch, 0, length) == _digito(barcode, 31) &&
+      digitoModulo10(barcode, 31, 40) == _digito(barcode, 41) &&
+      _digito(barcode, 42) == 0 &&
+      _digito(barcode, 43) == 0 &&
+      _digito(barcode, 44) == 0;
+  return CampoLivre(
+      carteira: _campo(barcode, 20, 22),
+      nossoNumero: _campo(barcode, 23, 30),
+      agencia: _campo(barcode, 32, 35),
+      conta: _campo(barcode, 36, 40),
+      digitosValidos: valid);
+}
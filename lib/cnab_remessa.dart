@@ -0,0 +1,246 @@
+import 'dart:typed_data';
+
+import 'barra_compacta.dart';
+import 'diario_leituras.dart';
+import 'vencimento.dart';
+
+// Company and account the payments are debited from, as written in the file and batch headers.
+class ContaCnab {
+  final int banco;
+  final String nomeBanco;
+
+  // 1 for CPF, 2 for CNPJ.
+  final int tipoInscricao;
+  final int inscricao;
+  final String convenio;
+  final int agencia;
+  final String dvAgencia;
+  final int conta;
+  final String dvConta;
+  final String nomeEmpresa;
+
+  const ContaCnab(
+      {required this.banco,
+      required this.nomeBanco,
+      this.tipoInscricao = 2,
+      required this.inscricao,
+      this.convenio = '',
+      required this.agencia,
+      this.dvAgencia = '',
+      required this.conta,
+      this.dvConta = '',
+      required this.nomeEmpresa});
+}
+
+// Receives a block of complete records. `bytes` is reused for the next block as soon as this returns, so it must be
+// consumed synchronously, e.g. with RandomAccessFile.writeFromSync(bytes, 0, length).
+typedef SaidaCnab = void Function(Uint8List bytes, int length);
+
+// Fixed-width records written straight into one reusable block: every record starts as spaces and the fields are
+// stored as bytes in place, numbers digit by digit from the right, so no string is built per field or per record.
+// Full blocks are handed to the output and the block is reused.
+abstract class _EscritorCnab {
+  final int tamanhoRegistro;
+  final SaidaCnab saida;
+  final Uint8List _bloco;
+  int _usado = 0;
+  int _base = 0;
+
+  final Uint8List _digitos = Uint8List(BarraCompacta.length);
+
+  _EscritorCnab(this.tamanhoRegistro, this.saida, int registrosPorBloco)
+      : _bloco = Uint8List((tamanhoRegistro + 2) * registrosPorBloco);
+
+  // Starts a record; the fields written next go into it.
+  void _novoRegistro() {
+    if (_usado + tamanhoRegistro + 2 > _bloco.length) _esvaziar();
+    _base = _usado;
+    _bloco.fillRange(_base, _base + tamanhoRegistro, 0x20);
+    _usado += tamanhoRegistro;
+    _bloco[_usado++] = 0x0d;
+    _bloco[_usado++] = 0x0a;
+  }
+
+  void _esvaziar() {
+    if (_usado > 0) saida(_bloco, _usado);
+    _usado = 0;
+  }
+
+  // Positions are 1-based, as in the layout manuals.
+  void _numero(int posicao, int tamanho, int valor) {
+    for (var i = _base + posicao + tamanho - 2; i >= _base + posicao - 1; i--) {
+      _bloco[i] = 0x30 + valor % 10;
+      valor ~/= 10;
+    }
+  }
+
+  // Left-aligned, truncated; lower case ASCII letters are upper-cased and anything outside ASCII becomes a space.
+  void _texto(int posicao, int tamanho, String valor) {
+    var n = valor.length < tamanho ? valor.length : tamanho;
+    for (var i = 0; i < n; i++) {
+      var unit = valor.codeUnitAt(i);
+      if (unit >= 0x61 && unit <= 0x7a) unit -= 0x20;
+      _bloco[_base + posicao - 1 + i] = unit < 0x80 ? unit : 0x20;
+    }
+  }
+
+  // DDMMAAAA from a yyyymmdd date; zeros when there is none.
+  void _data(int posicao, int yyyymmdd) {
+    _numero(posicao, 2, yyyymmdd % 100);
+    _numero(posicao + 2, 2, yyyymmdd ~/ 100 % 100);
+    _numero(posicao + 4, 4, yyyymmdd ~/ 10000);
+  }
+
+  void _codigoDeBarras(int posicao, BarraCompacta barcode) {
+    barcode.digitsInto(_digitos);
+    for (var i = 0; i < BarraCompacta.length; i++) {
+      _bloco[_base + posicao - 1 + i] = 0x30 + _digitos[i];
+    }
+  }
+}
+
+// FEBRABAN CNAB 240 payment file ("remessa de pagamentos") with one batch per call to iniciarLote, holding segment J
+// records (payment of boletos). Record counts and amount totals are kept as the records are written, so the batch
+// and file trailers need no second pass.
+class RemessaCnab240 extends _EscritorCnab {
+  final ContaCnab conta;
+
+  int _lote = 0;
+  int _registrosLote = 0;
+  int _valorLote = 0;
+  int _registrosArquivo = 0;
+  bool _loteAberto = false;
+
+  // Writes the file header. `nsa` is the file's sequence number and `geracao` its creation time.
+  RemessaCnab240(this.conta, SaidaCnab saida,
+      {required int nsa, required DateTime geracao, int registrosPorBloco = 256})
+      : super(240, saida, registrosPorBloco) {
+    _novoRegistro();
+    _numero(1, 3, conta.banco);
+    _numero(4, 4, 0);
+    _numero(8, 1, 0);
+    _empresa();
+    _texto(103, 30, conta.nomeBanco);
+    _numero(143, 1, 1);
+    _data(144, geracao.year * 10000 + geracao.month * 100 + geracao.day);
+    _numero(152, 2, geracao.hour);
+    _numero(154, 2, geracao.minute);
+    _numero(156, 2, geracao.second);
+    _numero(158, 6, nsa);
+    _numero(164, 3, 89);
+    _numero(167, 5, 1600);
+    _registrosArquivo++;
+  }
+
+  // Positions 18-102, common to the file and batch headers.
+  void _empresa() {
+    _numero(18, 1, conta.tipoInscricao);
+    _numero(19, 14, conta.inscricao);
+    _texto(33, 20, conta.convenio);
+    _numero(53, 5, conta.agencia);
+    _texto(58, 1, conta.dvAgencia);
+    _numero(59, 12, conta.conta);
+    _texto(71, 1, conta.dvConta);
+    _texto(73, 30, conta.nomeEmpresa);
+  }
+
+  // Starts a batch; boletos of the debited bank itself are paid with "forma de lançamento" 30 and the others with 31,
+  // each in their own batch.
+  void iniciarLote({required bool mesmoBanco}) {
+    if (_loteAberto) fecharLote();
+    _lote++;
+    _registrosLote = 0;
+    _valorLote = 0;
+    _loteAberto = true;
+
+    _novoRegistro();
+    _numero(1, 3, conta.banco);
+    _numero(4, 4, _lote);
+    _numero(8, 1, 1);
+    _texto(9, 1, 'C');
+    _numero(10, 2, 20);
+    _numero(12, 2, mesmoBanco ? 30 : 31);
+    _numero(14, 3, 40);
+    _empresa();
+    _registrosLote++;
+    _registrosArquivo++;
+  }
+
+  // Segment J for one boleto. The due date comes from the barcode, resolved against `diaPagamento` (see
+  // vencimento.dart); `valorPagamento` defaults to the amount in the barcode and `seuNumero` is the company's own
+  // reference, returned by the bank in the retorno file.
+  void adicionar(BarraCompacta barcode, {required int diaPagamento, int? valorPagamento, int seuNumero = 0}) {
+    assert(_loteAberto, 'iniciarLote must be called first');
+    var valor = barcode.valorCentavos;
+    var pago = valorPagamento ?? valor;
+
+    _novoRegistro();
+    _numero(1, 3, conta.banco);
+    _numero(4, 4, _lote);
+    _numero(8, 1, 3);
+    _numero(9, 5, _registrosLote);
+    _texto(14, 1, 'J');
+    _numero(15, 1, 0);
+    _numero(16, 2, 0);
+    _codigoDeBarras(18, barcode);
+    _data(92, dataDoDia(diaDoFator(barcode.fatorVencimento, diaPagamento)));
+    _numero(100, 15, valor);
+    _numero(115, 15, 0);
+    _numero(130, 15, 0);
+    _data(145, dataDoDia(diaPagamento));
+    _numero(153, 15, pago);
+    _numero(168, 15, 0);
+    _numero(183, 20, seuNumero);
+    _numero(223, 2, 9);
+    _registrosLote++;
+    _registrosArquivo++;
+    _valorLote += pago;
+  }
+
+  void fecharLote() {
+    if (!_loteAberto) return;
+    _loteAberto = false;
+    _novoRegistro();
+    _numero(1, 3, conta.banco);
+    _numero(4, 4, _lote);
+    _numero(8, 1, 5);
+    // The batch trailer counts itself.
+    _numero(18, 6, _registrosLote + 1);
+    _numero(24, 18, _valorLote);
+    _numero(42, 18, 0);
+    _registrosArquivo++;
+  }
+
+  // Writes the file trailer and hands out the last block.
+  void fechar() {
+    fecharLote();
+    _novoRegistro();
+    _numero(1, 3, conta.banco);
+    _numero(4, 4, 9999);
+    _numero(8, 1, 9);
+    _numero(18, 6, _lote);
+    _numero(24, 6, _registrosArquivo + 1);
+    _numero(30, 6, 0);
+    _esvaziar();
+  }
+}
+
+// Writes a complete CNAB 240 file paying every boleto in `journal` once on `diaPagamento`: one batch with those of the
+// debited bank and one with the others. The seu número of each segment J is the journal index + 1 of the boleto's
+// first scan, which the bank returns in the retorno for conciliarRetorno to join on.
+void escreverRemessa240(ContaCnab conta, DiarioLeituras journal, SaidaCnab saida,
+    {required int nsa, required DateTime geracao, required int diaPagamento}) {
+  var remessa = RemessaCnab240(conta, saida, nsa: nsa, geracao: geracao);
+  var pagos = ConjuntoBarras(journal.length);
+  for (var mesmoBanco in [true, false]) {
+    var iniciado = false;
+    for (var i = 0; i < journal.length; i++) {
+      var barcode = journal.barcodeAt(i);
+      if ((barcode.banco == conta.banco) != mesmoBanco || !pagos.add(barcode)) continue;
+      if (!iniciado) remessa.iniciarLote(mesmoBanco: mesmoBanco);
+      iniciado = true;
+      remessa.adicionar(barcode, diaPagamento: diaPagamento, seuNumero: i + 1);
+    }
+  }
+  remessa.fechar();
+}
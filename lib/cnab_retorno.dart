@@ -0,0 +1,251 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'barra_compacta.dart';
+import 'diario_leituras.dart';
+
+// One payment record of a retorno file, matched (or not) to the scan journal.
+class RegistroRetorno {
+  // 1-based record number in the file.
+  final int registro;
+
+  // Journal index of the latest scan of the boleto, -1 when none matches.
+  final int indiceJournal;
+  final int valorTitulo;
+  final int valorPago;
+
+  // The bank's two-character occurrence code packed as (first << 8) | second, e.g. "00" for paid.
+  final int ocorrencia;
+
+  RegistroRetorno(this.registro, this.indiceJournal, this.valorTitulo, this.valorPago, this.ocorrencia);
+}
+
+// Counters of a reconciliation run and, at the end, the scanned boletos the file did not mention.
+class Conciliacao {
+  int registros = 0;
+  int conciliados = 0;
+  int naoEncontrados = 0;
+  int divergentes = 0;
+
+  final Uint8List _retornados;
+
+  Conciliacao(int entradas) : _retornados = Uint8List(entradas);
+
+  List<int> get naoRetornados => [
+        for (var i = 0; i < _retornados.length; i++)
+          if (_retornados[i] == 0) i
+      ];
+}
+
+typedef ReceptorRegistro = void Function(RegistroRetorno registro);
+
+// Reads a CNAB 240 (segment J) retorno file and joins its payment records to the scan journal. Returns null when the
+// file does not start with a CNAB 240 file header; CNAB 400 retornos are bank specific and not read. The file is read
+// in blocks of `tamanhoBloco` bytes into one buffer with RandomAccessFile.readInto, and records are parsed in place in
+// that buffer, so memory stays bounded by the block size and the journal however large the file is; a record cut by
+// the end of a block is moved to the start of the buffer before the next read.
+//
+// The join runs on a hash table from packed barcode to journal index built once from the journal. Records without a
+// barcode (some banks leave it blank or zeroed in the retorno) fall back to the seu número, which escreverRemessa240
+// fills with the journal index + 1 and the bank returns unchanged. Each record goes to exactly one of `conciliado`,
+// `naoEncontrado` (no scan) or `valorDivergente` (paid amount differs from the scanned barcode's), and marks every scan
+// of its boleto as returned.
+Future<Conciliacao?> conciliarRetorno(String caminho, DiarioLeituras journal,
+    {ReceptorRegistro? conciliado,
+    ReceptorRegistro? naoEncontrado,
+    ReceptorRegistro? valorDivergente,
+    int tamanhoBloco = 1 << 20}) async {
+  assert(tamanhoBloco >= 240, 'a block must hold at least one record');
+  var indice = _IndiceBarcodes(journal);
+  var conciliacao = Conciliacao(journal.length);
+  var buffer = Uint8List(tamanhoBloco);
+  var arquivo = await File(caminho).open();
+  try {
+    var cheio = await arquivo.readInto(buffer);
+    var layout = _Layout.detectar(buffer, cheio);
+    if (layout == null) return null;
+    var inicio = 0;
+    var numero = 0;
+    var fim = false;
+
+    while (true) {
+      // Line breaks, if any, are skipped between records.
+      while (inicio < cheio && (buffer[inicio] == 0x0d || buffer[inicio] == 0x0a)) {
+        inicio++;
+      }
+      if (cheio - inicio < layout.tamanho) {
+        if (fim) break;
+        buffer.setRange(0, cheio - inicio, buffer, inicio);
+        cheio -= inicio;
+        inicio = 0;
+        var lidos = await arquivo.readInto(buffer, cheio);
+        if (lidos == 0) fim = true;
+        cheio += lidos;
+        continue;
+      }
+
+      numero++;
+      if (layout.ehPagamento(buffer, inicio)) {
+        conciliacao.registros++;
+        var indiceJournal = indice.buscar(buffer, inicio + layout.codigoDeBarras - 1);
+        if (indiceJournal < 0 && _vazio(buffer, inicio + layout.codigoDeBarras - 1, BarraCompacta.length)) {
+          var seuNumero = _numero(buffer, inicio + layout.seuNumero - 1, 20);
+          // Any later scan of the same boleto is the one reported, as for a record with its barcode.
+          if (seuNumero > 0 && seuNumero <= journal.length) {
+            indiceJournal = indice.ultimo(journal.barcodeAt(seuNumero - 1));
+          }
+        }
+        var registro = RegistroRetorno(
+            numero,
+            indiceJournal,
+            _numero(buffer, inicio + layout.valorTitulo - 1, layout.tamanhoValor),
+            _numero(buffer, inicio + layout.valorPago - 1, layout.tamanhoValor),
+            buffer[inicio + layout.ocorrencia - 1] << 8 | buffer[inicio + layout.ocorrencia]);
+
+        if (indiceJournal < 0) {
+          conciliacao.naoEncontrados++;
+          naoEncontrado?.call(registro);
+        } else {
+          for (var i = indiceJournal; i >= 0; i = indice.anterior(i)) {
+            conciliacao._retornados[i] = 1;
+          }
+          var valorEscaneado = journal.barcodeAt(indiceJournal).valorCentavos;
+          // A barcode without an amount (0) accepts any payment.
+          if (valorEscaneado != 0 && valorEscaneado != registro.valorPago) {
+            conciliacao.divergentes++;
+            valorDivergente?.call(registro);
+          } else {
+            conciliacao.conciliados++;
+            conciliado?.call(registro);
+          }
+        }
+      }
+      inicio += layout.tamanho;
+    }
+  } finally {
+    await arquivo.close();
+  }
+  return conciliacao;
+}
+
+// Field positions (1-based, as in the manuals) of the payment detail records.
+class _Layout {
+  final int tamanho;
+  final int codigoDeBarras;
+  final int valorTitulo;
+  final int valorPago;
+  final int tamanhoValor;
+  final int ocorrencia;
+  final int seuNumero;
+
+  const _Layout(this.tamanho, this.codigoDeBarras, this.valorTitulo, this.valorPago, this.tamanhoValor,
+      this.ocorrencia, this.seuNumero);
+
+  // CNAB 240 segment J.
+  static const _Layout cnab240 = _Layout(240, 18, 100, 153, 15, 231, 183);
+
+  // Record type 3, segment J.
+  bool ehPagamento(Uint8List bytes, int inicio) => bytes[inicio + 7] == 0x33 && bytes[inicio + 13] == 0x4a;
+
+  // A CNAB 240 file header has "0000" as batch and "0" as record type in positions 4-8. Anything else, CNAB 400
+  // included, is not recognized: 400-position retornos differ from bank to bank.
+  static _Layout? detectar(Uint8List bytes, int length) {
+    if (length < 8) return null;
+    var lote0 = bytes[3] == 0x30 && bytes[4] == 0x30 && bytes[5] == 0x30 && bytes[6] == 0x30 && bytes[7] == 0x30;
+    return lote0 ? cnab240 : null;
+  }
+}
+
+// Digits in bytes[start, start + length) as a number, ignoring spaces; -1 if anything else is found or the value
+// does not fit in 18 digits.
+int _numero(Uint8List bytes, int start, int length) {
+  var valor = 0, digitos = 0;
+  for (var i = start; i < start + length; i++) {
+    var b = bytes[i];
+    if (b == 0x20) continue;
+    var digit = b - 0x30;
+    if (digit < 0 || digit > 9) return -1;
+    if (valor > 0 || digit > 0) digitos++;
+    if (digitos > 18) return -1;
+    valor = valor * 10 + digit;
+  }
+  return valor;
+}
+
+// Whether bytes[start, start + length) holds only spaces or zeros.
+bool _vazio(Uint8List bytes, int start, int length) {
+  for (var i = start; i < start + length; i++) {
+    if (bytes[i] != 0x20 && bytes[i] != 0x30) return false;
+  }
+  return true;
+}
+
+// Open addressing table from packed barcode to the latest journal index scanning it, stored column-wise like
+// ConjuntoBarras. Earlier scans of the same barcode are chained from there through `anterior`.
+class _IndiceBarcodes {
+  final Int64List _hi;
+  final Int64List _mid;
+  final Int64List _lo;
+  final Int32List _indices;
+  final Int32List _anteriores;
+
+  _IndiceBarcodes(DiarioLeituras journal)
+      : _hi = Int64List(_capacidade(journal.length))..fillRange(0, _capacidade(journal.length), -1),
+        _mid = Int64List(_capacidade(journal.length)),
+        _lo = Int64List(_capacidade(journal.length)),
+        _indices = Int32List(_capacidade(journal.length)),
+        _anteriores = Int32List(journal.length) {
+    for (var i = 0; i < journal.length; i++) {
+      var barcode = journal.barcodeAt(i);
+      var slot = _slot(barcode.hi, barcode.mid, barcode.lo);
+      _anteriores[i] = _hi[slot] == -1 ? -1 : _indices[slot];
+      _hi[slot] = barcode.hi;
+      _mid[slot] = barcode.mid;
+      _lo[slot] = barcode.lo;
+      _indices[slot] = i;
+    }
+  }
+
+  static int _capacidade(int entradas) {
+    var capacidade = 16;
+    while (capacidade < entradas * 2) {
+      capacidade <<= 1;
+    }
+    return capacidade;
+  }
+
+  int _slot(int hi, int mid, int lo) {
+    var mask = _hi.length - 1;
+    var slot = BarraCompacta.hashWords(hi, mid, lo) & mask;
+    while (_hi[slot] != -1 && (_hi[slot] != hi || _mid[slot] != mid || _lo[slot] != lo)) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  // Journal index of the previous scan of the same barcode as journal entry `indice`, or -1.
+  int anterior(int indice) => _anteriores[indice];
+
+  // Journal index of the latest scan of the 44 ASCII digits at bytes[start], or -1.
+  int buscar(Uint8List bytes, int start) {
+    var hi = _palavra(bytes, start, 18);
+    var mid = _palavra(bytes, start + 18, 18);
+    var lo = _palavra(bytes, start + 36, 8);
+    if (hi < 0 || mid < 0 || lo < 0) return -1;
+    var slot = _slot(hi, mid, lo);
+    return _hi[slot] == -1 ? -1 : _indices[slot];
+  }
+
+  // Journal index of the latest scan of `barcode`, which is in the journal.
+  int ultimo(BarraCompacta barcode) => _indices[_slot(barcode.hi, barcode.mid, barcode.lo)];
+
+  static int _palavra(Uint8List bytes, int start, int length) {
+    var valor = 0;
+    for (var i = start; i < start + length; i++) {
+      var digit = bytes[i] - 0x30;
+      if (digit < 0 || digit > 9) return -1;
+      valor = valor * 10 + digit;
+    }
+    return valor;
+  }
+}
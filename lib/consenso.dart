@@ -0,0 +1,111 @@
+import 'dart:typed_data';
+
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+import 'boleto.dart';
+import 'rastros.dart';
+
+// Trade-off between latency and accuracy of the consensus stage.
+class ParametrosConsenso {
+  // Reads of the same barcode that are voted on before the per-digit majority is emitted. The majority is only
+  // emitted once every digit has it outright (more than half of the track's reads); until then the track keeps
+  // collecting reads.
+  final int leiturasNecessarias;
+
+  // Emit a read whose general check digit matches right away, without waiting for more frames.
+  final bool aceitarLeituraValida;
+
+  // A read more than this many frames after the previous read of a track starts a new track.
+  final int maxIntervaloFrames;
+
+  const ParametrosConsenso(
+      {this.leiturasNecessarias = 3, this.aceitarLeituraValida = true, this.maxIntervaloFrames = 15});
+
+  // As fast as without consensus for clean reads; only reads failing the check digit wait for more frames.
+  static const ParametrosConsenso rapido = ParametrosConsenso();
+
+  // Every read, valid or not, needs three agreeing frames.
+  static const ParametrosConsenso preciso = ParametrosConsenso(leiturasNecessarias: 3, aceitarLeituraValida: false);
+}
+
+// Collects 44-digit ITF reads of the same barcode across consecutive frames and votes per digit. Reads are matched to
+// a track by frame sequence id and overlap of their locations (see rastros.dart); the fixed number of tracks and the
+// 44 x 10 vote counters per track keep memory constant.
+class ConsensoLeituras {
+  static const int _tracks = 4;
+  static const int _digitos = 44;
+
+  final ParametrosConsenso settings;
+
+  final Uint16List _votos = Uint16List(_tracks * _digitos * 10);
+  final Int32List _leituras = Int32List(_tracks);
+  final RastrosLocalizacao _localizacoes;
+  final Uint8List _scratch = Uint8List(_digitos);
+
+  ConsensoLeituras([this.settings = ParametrosConsenso.rapido])
+      : _localizacoes = RastrosLocalizacao(_tracks, settings.maxIntervaloFrames);
+
+  // Adds one read and returns the barcode to accept, or null while the consensus is still pending.
+  String? adicionar(String valor, Quadrilateral location, int frameSequenceId) {
+    if (valor.length != _digitos) return valor;
+    for (var i = 0; i < _digitos; i++) {
+      var digit = valor.codeUnitAt(i) - 0x30;
+      if (digit < 0 || digit > 9) return valor;
+      _scratch[i] = digit;
+    }
+
+    var valida = digitoModulo11Banco(_scratch) == _scratch[4];
+    if (valida && settings.aceitarLeituraValida) {
+      _descartarTrackDe(location, frameSequenceId);
+      return valor;
+    }
+
+    var track = _localizacoes.trackPara(location, frameSequenceId);
+    if (!_localizacoes.ativo(track)) _limpar(track);
+    var base = track * _digitos * 10;
+    for (var i = 0; i < _digitos; i++) {
+      _votos[base + i * 10 + _scratch[i]]++;
+    }
+    _leituras[track]++;
+    _localizacoes.atualizar(track, location, frameSequenceId);
+
+    if (_leituras[track] < settings.leiturasNecessarias) return null;
+    var maioria = _maioria(track);
+    if (maioria != null) _limpar(track);
+    return maioria;
+  }
+
+  void reset() {
+    for (var track = 0; track < _tracks; track++) {
+      _limpar(track);
+    }
+  }
+
+  // The digit voted by more than half of the track's reads at every position, or null when a position has no such
+  // digit (split or tied votes).
+  String? _maioria(int track) {
+    var base = track * _digitos * 10;
+    var leituras = _leituras[track];
+    var chars = Uint8List(_digitos);
+    for (var i = 0; i < _digitos; i++) {
+      var melhor = 0;
+      for (var digit = 1; digit < 10; digit++) {
+        if (_votos[base + i * 10 + digit] > _votos[base + i * 10 + melhor]) melhor = digit;
+      }
+      if (_votos[base + i * 10 + melhor] * 2 <= leituras) return null;
+      chars[i] = melhor + 0x30;
+    }
+    return String.fromCharCodes(chars);
+  }
+
+  void _descartarTrackDe(Quadrilateral location, int frame) {
+    var track = _localizacoes.encontrar(location, frame);
+    if (track >= 0) _limpar(track);
+  }
+
+  void _limpar(int track) {
+    _votos.fillRange(track * _digitos * 10, (track + 1) * _digitos * 10, 0);
+    _leituras[track] = 0;
+    _localizacoes.desativar(track);
+  }
+}
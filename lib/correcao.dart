@@ -0,0 +1,136 @@
+import 'dart:typed_data';
+
+import 'bancos.dart';
+import 'barra_compacta.dart';
+import 'boleto.dart';
+
+// Recovery for barcodes whose general check digit (position 5) does not match. The modulo 11 check digit is a
+// weighted sum with weights 2-9, all invertible modulo 11, so for every position the replacement digits that make the
+// sum hit the check digit can be solved in closed form instead of trying all of them. The same holds for swapping two
+// neighbouring digits. This enumerates every single-digit substitution and adjacent transposition consistent with
+// the check digit, which takes a few hundred integer operations and can run inline on every failed read.
+class CorrecaoCandidata {
+  static const int substituicao = 0;
+  static const int transposicao = 1;
+
+  final BarraCompacta barcode;
+  final int tipo;
+
+  // First (0-based) barcode index changed; a transposition also changes `posicao + 1`.
+  final int posicao;
+
+  // Higher is more plausible, see ordenarCorrecoes.
+  int pontuacao = 0;
+
+  CorrecaoCandidata(this.barcode, this.tipo, this.posicao);
+}
+
+// Weight of each barcode index in the check digit sum; index 4 (the check digit itself) has none.
+final Int8List _pesos = () {
+  var pesos = Int8List(44);
+  for (var i = 0; i < 44; i++) {
+    if (i == 4) continue;
+    // Distance from the rightmost digit, skipping the check digit.
+    var k = i > 4 ? 43 - i : 42 - i;
+    pesos[i] = 2 + k % 8;
+  }
+  return pesos;
+}();
+
+// Inverses modulo 11 of 0-10 (0 has none).
+const List<int> _inversos = [0, 1, 6, 4, 3, 9, 2, 8, 7, 5, 10];
+
+// Sum residues (modulo 11) that produce check digit `dv`: 11 - r, with 10 and 11 mapping to 0 and then to 1.
+List<int> _residuosPara(int dv) {
+  if (dv == 1) return const [0, 1, 10];
+  if (dv >= 2 && dv <= 9) return [11 - dv];
+  return const [];
+}
+
+// All single-digit substitutions and adjacent transpositions of `digits` (44 digit values) that satisfy the check
+// digit, including a misread check digit itself.
+List<CorrecaoCandidata> enumerarCorrecoes(Uint8List digits) {
+  var candidatas = <CorrecaoCandidata>[];
+  var soma = 0;
+  for (var i = 0; i < 44; i++) {
+    soma += digits[i] * _pesos[i];
+  }
+  var residuo = soma % 11;
+  var dv = digits[4];
+  var residuos = _residuosPara(dv);
+  var scratch = Uint8List.fromList(digits);
+
+  void adicionar(int tipo, int posicao) {
+    candidatas.add(CorrecaoCandidata(BarraCompacta.fromDigits(scratch)!, tipo, posicao));
+  }
+
+  // The check digit itself was misread.
+  var correto = digitoModulo11Banco(digits);
+  if (correto != dv) {
+    scratch[4] = correto;
+    adicionar(CorrecaoCandidata.substituicao, 4);
+    scratch[4] = dv;
+  }
+
+  // Substitutions: weight * delta must move the residue onto one of the accepted residues.
+  for (var i = 0; i < 44; i++) {
+    if (i == 4) continue;
+    var inverso = _inversos[_pesos[i]];
+    for (var alvo in residuos) {
+      var delta = (alvo - residuo) * inverso % 11;
+      if (delta < 0) delta += 11;
+      if (delta == 0) continue;
+      for (var novo in [digits[i] + delta, digits[i] + delta - 11]) {
+        if (novo >= 0 && novo <= 9) {
+          scratch[i] = novo;
+          adicionar(CorrecaoCandidata.substituicao, i);
+        }
+      }
+      scratch[i] = digits[i];
+    }
+  }
+
+  // Adjacent transpositions.
+  for (var i = 0; i < 43; i++) {
+    var a = digits[i], b = digits[i + 1];
+    if (a == b) continue;
+    scratch[i] = b;
+    scratch[i + 1] = a;
+    if (i == 3 || i == 4) {
+      // The swap moves the check digit, recompute it directly.
+      if (scratch[4] == digitoModulo11Banco(scratch)) adicionar(CorrecaoCandidata.transposicao, i);
+    } else {
+      var novoResiduo = (soma + (_pesos[i] - _pesos[i + 1]) * (b - a)) % 11;
+      if (residuos.contains(novoResiduo < 0 ? novoResiduo + 11 : novoResiduo)) {
+        adicionar(CorrecaoCandidata.transposicao, i);
+      }
+    }
+    scratch[i] = a;
+    scratch[i + 1] = b;
+  }
+  return candidatas;
+}
+
+// Scores candidates and sorts them best first. Every other read of the same barcode (e.g. from earlier frames) that
+// agrees with a candidate at the changed positions counts two points; a known bank code and the real currency code
+// (9) count one point each as structural plausibility, since the engine does not report per-digit confidence.
+List<CorrecaoCandidata> ordenarCorrecoes(List<CorrecaoCandidata> candidatas, [List<Uint8List> observacoes = const []]) {
+  var digits = Uint8List(BarraCompacta.length);
+  for (var candidata in candidatas) {
+    candidata.barcode.digitsInto(digits);
+    var pontuacao = 0;
+    var fim = candidata.tipo == CorrecaoCandidata.transposicao ? candidata.posicao + 1 : candidata.posicao;
+    for (var observacao in observacoes) {
+      var concorda = true;
+      for (var i = candidata.posicao; i <= fim; i++) {
+        if (observacao[i] != digits[i]) concorda = false;
+      }
+      if (concorda) pontuacao += 2;
+    }
+    if (bancoPorCodigo(candidata.barcode.banco) != null) pontuacao++;
+    if (digits[3] == 9) pontuacao++;
+    candidata.pontuacao = pontuacao;
+  }
+  candidatas.sort((a, b) => b.pontuacao - a.pontuacao);
+  return candidatas;
+}
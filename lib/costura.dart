@@ -0,0 +1,125 @@
+import 'dart:typed_data';
+
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+import 'bancos.dart';
+import 'boleto.dart';
+import 'rastros.dart';
+
+// Stitches partial reads of a damaged boleto barcode across frames. The capture settings accept ITF reads of 40 to
+// 50 digits, so a torn or stained barcode often decodes with some digits missing at one end. Each span is placed
+// at its position within the 44-digit layout and votes per digit; once every position has been seen, the majority is
+// accepted only if the general check digit and the field structure validate.
+//
+// Tracks are matched by location overlap like in ConsensoLeituras (see rastros.dart); a fixed number of tracks with
+// 44 x 10 vote counters each keeps memory bounded no matter how many frames arrive.
+class CosturaParcial {
+  static const int _tracks = 4;
+  static const int _digitos = 44;
+
+  final int maxIntervaloFrames;
+
+  // Minimum fraction of already voted positions an unaligned span must agree with to be placed at an offset.
+  final double concordanciaMinima;
+
+  final Uint16List _votos = Uint16List(_tracks * _digitos * 10);
+  final Uint16List _cobertura = Uint16List(_tracks * _digitos);
+  final RastrosLocalizacao _localizacoes;
+  final Uint8List _trecho = Uint8List(64);
+
+  CosturaParcial({this.maxIntervaloFrames = 30, this.concordanciaMinima = 0.8})
+      : _localizacoes = RastrosLocalizacao(_tracks, maxIntervaloFrames);
+
+  // Adds a read of any length. Returns a complete, validated 44-digit barcode once the track it belongs to can be
+  // assembled, otherwise null.
+  String? adicionar(String valor, Quadrilateral location, int frameSequenceId) {
+    var length = valor.length;
+    if (length < 8 || length > _digitos) return null;
+    for (var i = 0; i < length; i++) {
+      var digit = valor.codeUnitAt(i) - 0x30;
+      if (digit < 0 || digit > 9) return null;
+      _trecho[i] = digit;
+    }
+
+    var track = _localizacoes.trackPara(location, frameSequenceId);
+    if (!_localizacoes.ativo(track)) _limpar(track);
+    var offset = length == _digitos ? 0 : _alinhar(track, length);
+    if (offset < 0) return null;
+
+    var base = track * _digitos;
+    for (var i = 0; i < length; i++) {
+      _votos[(base + offset + i) * 10 + _trecho[i]]++;
+      _cobertura[base + offset + i]++;
+    }
+    _localizacoes.atualizar(track, location, frameSequenceId);
+
+    var montado = _montar(track);
+    if (montado != null) _limpar(track);
+    return montado;
+  }
+
+  void reset() {
+    for (var track = 0; track < _tracks; track++) {
+      _limpar(track);
+    }
+  }
+
+  // Offset of the span in _trecho[0, length) within the 44 digits, or -1 if it cannot be placed.
+  int _alinhar(int track, int length) {
+    var base = track * _digitos;
+    var melhor = -1;
+    var melhorConcordancia = concordanciaMinima;
+    var comparadas = 0;
+    for (var offset = 0; offset + length <= _digitos; offset++) {
+      var votadas = 0, concordam = 0;
+      for (var i = 0; i < length; i++) {
+        var posicao = base + offset + i;
+        if (_cobertura[posicao] == 0) continue;
+        votadas++;
+        if (_maioria(posicao) == _trecho[i]) concordam++;
+      }
+      // Require a real overlap, not a couple of coincidental digits.
+      if (votadas < 8) continue;
+      comparadas++;
+      var concordancia = concordam / votadas;
+      if (concordancia > melhorConcordancia) {
+        melhor = offset;
+        melhorConcordancia = concordancia;
+      }
+    }
+    if (comparadas > 0) return melhor;
+
+    // Nothing to align against yet: a truncated read keeps one of the two ends. A span that starts with a known bank
+    // code followed by the currency code (9) is the head of the barcode, anything else is taken as the tail.
+    var banco = _trecho[0] * 100 + _trecho[1] * 10 + _trecho[2];
+    return _trecho[3] == 9 && bancoPorCodigo(banco) != null ? 0 : _digitos - length;
+  }
+
+  int _maioria(int posicao) {
+    var melhor = 0;
+    for (var digit = 1; digit < 10; digit++) {
+      if (_votos[posicao * 10 + digit] > _votos[posicao * 10 + melhor]) melhor = digit;
+    }
+    return melhor;
+  }
+
+  String? _montar(int track) {
+    var base = track * _digitos;
+    var digits = Uint8List(_digitos);
+    for (var i = 0; i < _digitos; i++) {
+      if (_cobertura[base + i] == 0) return null;
+      digits[i] = _maioria(base + i);
+    }
+    // Structure: currency code 9 (real), a due date factor that is either absent or in the valid range, and the
+    // general check digit.
+    var fator = digits[5] * 1000 + digits[6] * 100 + digits[7] * 10 + digits[8];
+    if (digits[3] != 9 || (fator != 0 && fator < 1000) || digitoModulo11Banco(digits) != digits[4]) return null;
+    return String.fromCharCodes(digits.map((digit) => digit + 0x30));
+  }
+
+  void _limpar(int track) {
+    _votos.fillRange(track * _digitos * 10, (track + 1) * _digitos * 10, 0);
+    _cobertura.fillRange(track * _digitos, (track + 1) * _digitos, 0);
+    _localizacoes.desativar(track);
+  }
+}
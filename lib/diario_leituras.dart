@@ -0,0 +1,194 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'barra_compacta.dart';
+
+// Every boleto scanned on the device, in scan order, stored column-wise: the three packed words and the scan time,
+// 32 bytes per entry. Alongside it a sorted index over the digitable lines answers "which entries start with these
+// digits" with two binary searches, which is what the history screen runs on every keystroke.
+//
+// The index key is the first 18 digits of the digitable line as a number, so a prefix of k <= 18 digits is the key
+// range [prefix * 10^(18 - k), (prefix + 1) * 10^(18 - k)). Longer prefixes narrow that range by comparing the
+// remaining digits. New entries are inserted into the index in place.
+//
+// A journal opened with abrir is kept in an append-only file of 32-byte records, the three packed words and the scan
+// time in milliseconds, little endian: each scan costs one small write, nothing is ever rewritten, and loading is one
+// read of the whole file followed by a single sort for the index.
+class DiarioLeituras {
+  static const int _digitosChave = 18;
+  static const int _tamanhoRegistro = 32;
+
+  Int64List _hi = Int64List(64);
+  Int64List _mid = Int64List(64);
+  Int64List _lo = Int64List(64);
+  Int64List _momentos = Int64List(64);
+  int _length = 0;
+
+  Int64List _chaves = Int64List(64);
+  Int32List _ordem = Int32List(64);
+
+  final Uint8List _linha = Uint8List(47);
+
+  RandomAccessFile? _arquivo;
+  final ByteData _registro = ByteData(_tamanhoRegistro);
+
+  // An empty journal kept in memory only.
+  DiarioLeituras();
+
+  // Loads the journal kept in `caminho`, creating the file if needed; entries added afterwards are appended to it. A
+  // record cut short by a crash while it was written is dropped.
+  static Future<DiarioLeituras> abrir(String caminho) async {
+    var journal = DiarioLeituras();
+    var arquivo = await File(caminho).open(mode: FileMode.append);
+    var tamanho = await arquivo.length();
+    var completos = tamanho - tamanho % _tamanhoRegistro;
+    if (completos > 0) {
+      await arquivo.setPosition(0);
+      journal._carregar(ByteData.sublistView(await arquivo.read(completos)));
+    }
+    if (completos != tamanho) await arquivo.truncate(completos);
+    await arquivo.setPosition(completos);
+    journal._arquivo = arquivo;
+    return journal;
+  }
+
+  int get length => _length;
+
+  BarraCompacta barcodeAt(int index) => BarraCompacta(_hi[index], _mid[index], _lo[index]);
+
+  DateTime momentoAt(int index) => DateTime.fromMillisecondsSinceEpoch(_momentos[index]);
+
+  // Appends a scan and returns its index.
+  int add(BarraCompacta code, DateTime momento) {
+    if (_length == _hi.length) _grow();
+    var index = _length++;
+    _hi[index] = code.hi;
+    _mid[index] = code.mid;
+    _lo[index] = code.lo;
+    _momentos[index] = momento.millisecondsSinceEpoch;
+
+    var arquivo = _arquivo;
+    if (arquivo != null) {
+      _registro
+        ..setInt64(0, code.hi, Endian.little)
+        ..setInt64(8, code.mid, Endian.little)
+        ..setInt64(16, code.lo, Endian.little)
+        ..setInt64(24, _momentos[index], Endian.little);
+      arquivo.writeFromSync(Uint8List.sublistView(_registro));
+    }
+
+    // Equal keys stay in scan order, so the new entry goes after them.
+    var chave = _chave(code.linhaDigitsInto(_linha));
+    var posicao = _limite(chave + 1, index);
+    _chaves.setRange(posicao + 1, index + 1, _chaves, posicao);
+    _ordem.setRange(posicao + 1, index + 1, _ordem, posicao);
+    _chaves[posicao] = chave;
+    _ordem[posicao] = index;
+    return index;
+  }
+
+  // Indexes of the entries whose digitable line starts with the digits in `consulta` (anything else, like the dots
+  // and spaces of a formatted line, is ignored), newest first, at most `limite` of them.
+  List<int> buscarPrefixo(String consulta, {int limite = 500}) {
+    var prefixo = <int>[
+      for (var unit in consulta.codeUnits)
+        if (unit >= 0x30 && unit <= 0x39) unit - 0x30
+    ];
+    if (prefixo.length > 47) return const [];
+
+    var k = prefixo.length < _digitosChave ? prefixo.length : _digitosChave;
+    var valor = 0;
+    for (var i = 0; i < k; i++) {
+      valor = valor * 10 + prefixo[i];
+    }
+    var escala = 1;
+    for (var i = k; i < _digitosChave; i++) {
+      escala *= 10;
+    }
+    var inicio = _limite(valor * escala, _length);
+    var fim = _limite((valor + 1) * escala, _length);
+
+    var resultado = <int>[];
+    for (var i = inicio; i < fim; i++) {
+      var index = _ordem[i];
+      if (prefixo.length > _digitosChave && !_continua(index, prefixo)) continue;
+      resultado.add(index);
+    }
+    // The range is ordered by key; the history lists newest first.
+    resultado.sort((a, b) => b - a);
+    return resultado.length > limite ? resultado.sublist(0, limite) : resultado;
+  }
+
+  Future<void> fechar() async {
+    var arquivo = _arquivo;
+    _arquivo = null;
+    await arquivo?.close();
+  }
+
+  // Appends the records in `registros` and builds the index with one sort instead of one insertion per entry.
+  void _carregar(ByteData registros) {
+    var n = registros.lengthInBytes ~/ _tamanhoRegistro;
+    while (_hi.length < n) {
+      _grow();
+    }
+    for (var i = 0; i < n; i++) {
+      var offset = i * _tamanhoRegistro;
+      _hi[i] = registros.getInt64(offset, Endian.little);
+      _mid[i] = registros.getInt64(offset + 8, Endian.little);
+      _lo[i] = registros.getInt64(offset + 16, Endian.little);
+      _momentos[i] = registros.getInt64(offset + 24, Endian.little);
+    }
+    _length = n;
+
+    var chaves = Int64List(n);
+    for (var i = 0; i < n; i++) {
+      chaves[i] = _chave(barcodeAt(i).linhaDigitsInto(_linha));
+    }
+    var ordem = List<int>.generate(n, (i) => i)
+      ..sort((a, b) => chaves[a] != chaves[b] ? chaves[a].compareTo(chaves[b]) : a - b);
+    for (var i = 0; i < n; i++) {
+      _ordem[i] = ordem[i];
+      _chaves[i] = chaves[ordem[i]];
+    }
+  }
+
+  bool _continua(int index, List<int> prefixo) {
+    barcodeAt(index).linhaDigitsInto(_linha);
+    for (var i = _digitosChave; i < prefixo.length; i++) {
+      if (_linha[i] != prefixo[i]) return false;
+    }
+    return true;
+  }
+
+  static int _chave(Uint8List linha) {
+    var chave = 0;
+    for (var i = 0; i < _digitosChave; i++) {
+      chave = chave * 10 + linha[i];
+    }
+    return chave;
+  }
+
+  // First position among the first `n` index entries whose key is >= `chave`.
+  int _limite(int chave, int n) {
+    var baixo = 0, alto = n - 1;
+    while (baixo <= alto) {
+      var meio = (baixo + alto) >> 1;
+      if (_chaves[meio] < chave) {
+        baixo = meio + 1;
+      } else {
+        alto = meio - 1;
+      }
+    }
+    return baixo;
+  }
+
+  void _grow() {
+    var capacity = _hi.length * 2;
+    _hi = Int64List(capacity)..setRange(0, _length, _hi);
+    _mid = Int64List(capacity)..setRange(0, _length, _mid);
+    _lo = Int64List(capacity)..setRange(0, _length, _lo);
+    _momentos = Int64List(capacity)..setRange(0, _length, _momentos);
+    _chaves = Int64List(capacity)..setRange(0, _length, _chaves);
+    _ordem = Int32List(capacity)..setRange(0, _length, _ordem);
+  }
+}
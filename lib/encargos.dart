@@ -0,0 +1,126 @@
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'vencimento.dart';
+
+// Late fee (multa), daily interest (juros) and early payment discount (desconto) for batches of decoded boletos.
+// Amounts are integer cents and rates are basis points, and every result is rounded half up exactly once, so the
+// reconciliation totals match the bank's to the cent instead of drifting with double arithmetic.
+class RegrasEncargos {
+  // One-off fine on late payment, e.g. 200 for 2%.
+  final int multaBasisPoints;
+
+  // Monthly interest charged pro rata per calendar day of delay (monthly rate / 30), e.g. 100 for 1% a.m.
+  final int jurosMensalBasisPoints;
+
+  // Discount per calendar day paid before the due date, capped at `descontoMaximoBasisPoints`.
+  final int descontoDiarioBasisPoints;
+  final int descontoMaximoBasisPoints;
+
+  const RegrasEncargos(
+      {this.multaBasisPoints = 200,
+      this.jurosMensalBasisPoints = 100,
+      this.descontoDiarioBasisPoints = 0,
+      this.descontoMaximoBasisPoints = 0});
+}
+
+// Struct-of-arrays batch: inputs are amounts in cents and due/payment days (see vencimento.dart); the outputs are
+// filled by calcularEncargos.
+class LoteEncargos {
+  final Int64List valores;
+  final Int32List vencimentos;
+  final Int32List pagamentos;
+
+  final Int64List multas;
+  final Int64List juros;
+  final Int64List descontos;
+  final Int64List totais;
+
+  LoteEncargos(this.valores, this.vencimentos, this.pagamentos)
+      : assert(valores.length == vencimentos.length && valores.length == pagamentos.length),
+        multas = Int64List(valores.length),
+        juros = Int64List(valores.length),
+        descontos = Int64List(valores.length),
+        totais = Int64List(valores.length);
+
+  int get length => valores.length;
+}
+
+// Integer division rounded half up; both operands are non-negative.
+int _dividirArredondando(int dividendo, int divisor) => (dividendo + divisor ~/ 2) ~/ divisor;
+
+void calcularEncargos(LoteEncargos lote, RegrasEncargos regras, [int inicio = 0, int? fim]) {
+  var valores = lote.valores, vencimentos = lote.vencimentos, pagamentos = lote.pagamentos;
+  var multas = lote.multas, juros = lote.juros, descontos = lote.descontos, totais = lote.totais;
+  var multaBp = regras.multaBasisPoints;
+  var jurosBp = regras.jurosMensalBasisPoints;
+  var descontoBp = regras.descontoDiarioBasisPoints;
+  var descontoMaximoBp = regras.descontoMaximoBasisPoints;
+
+  for (var i = inicio, n = fim ?? lote.length; i < n; i++) {
+    var valor = valores[i];
+    var vencimento = vencimentos[i];
+    var pagamento = pagamentos[i];
+    var multa = 0, juro = 0, desconto = 0;
+
+    if (vencimento >= 0) {
+      // Due dates on weekends or holidays move to the next business day; interest still counts from the due date.
+      if (pagamento > proximoDiaUtil(vencimento)) {
+        var atraso = pagamento - vencimento;
+        multa = _dividirArredondando(valor * multaBp, 10000);
+        juro = _dividirArredondando(valor * jurosBp * atraso, 300000);
+      } else if (pagamento < vencimento && descontoBp > 0) {
+        var bp = (vencimento - pagamento) * descontoBp;
+        if (bp > descontoMaximoBp) bp = descontoMaximoBp;
+        desconto = _dividirArredondando(valor * bp, 10000);
+      }
+    }
+
+    multas[i] = multa;
+    juros[i] = juro;
+    descontos[i] = desconto;
+    totais[i] = valor + multa + juro - desconto;
+  }
+}
+
+// Splits the batch into `partes` ranges and computes them on background isolates. Each part is copied to its
+// isolate and its results are copied back into `lote`. Isolates are spawned with dart:isolate rather than Flutter's
+// compute, so the batch engine also runs in plain Dart, e.g. the reconciliation job or benchmark/.
+Future<void> calcularEncargosEmParalelo(LoteEncargos lote, RegrasEncargos regras, {int partes = 4}) async {
+  var tamanho = (lote.length + partes - 1) ~/ partes;
+  var tarefas = <Future<void>>[];
+  for (var inicio = 0; inicio < lote.length; inicio += tamanho) {
+    var fim = inicio + tamanho < lote.length ? inicio + tamanho : lote.length;
+    var parte = LoteEncargos(lote.valores.sublist(inicio, fim), lote.vencimentos.sublist(inicio, fim),
+        lote.pagamentos.sublist(inicio, fim));
+    tarefas.add(_calcularEmIsolate(parte, regras).then((resultado) {
+      lote.multas.setRange(inicio, fim, resultado.multas);
+      lote.juros.setRange(inicio, fim, resultado.juros);
+      lote.descontos.setRange(inicio, fim, resultado.descontos);
+      lote.totais.setRange(inicio, fim, resultado.totais);
+    }));
+  }
+  await Future.wait(tarefas);
+}
+
+Future<LoteEncargos> _calcularEmIsolate(LoteEncargos lote, RegrasEncargos regras) async {
+  var porta = ReceivePort();
+  await Isolate.spawn(_calcularParte, _Parte(lote, regras, porta.sendPort), onError: porta.sendPort);
+  var resposta = await porta.first;
+  if (resposta is LoteEncargos) return resposta;
+  var erro = resposta as List<dynamic>;
+  throw RemoteError('${erro[0]}', '${erro[1]}');
+}
+
+class _Parte {
+  final LoteEncargos lote;
+  final RegrasEncargos regras;
+  final SendPort resposta;
+
+  _Parte(this.lote, this.regras, this.resposta);
+}
+
+void _calcularParte(_Parte parte) {
+  calcularEncargos(parte.lote, parte.regras);
+  parte.resposta.send(parte.lote);
+}
@@ -0,0 +1,168 @@
+import 'dart:io' show ZLibEncoder;
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'anel_quadros.dart';
+
+// Rectifies the region of a frame covered by a barcode's location quadrilateral into an axis-aligned strip of fixed
+// height, so a few kilobytes of evidence are kept per read instead of the full frame. The scanner screen rectifies
+// every journaled boleto whose frame is still in its AnelQuadrosLuma and stores the strip as a PNG (see
+// codificarPngCinza) next to the journal; like the ring, it produces nothing until a frame source feeds it.
+//
+// Corners are plain coordinates rather than the plugin's Quadrilateral so that the warp runs without Flutter, in
+// tests and benchmarks.
+class FaixaCodigo {
+  final int width;
+  final int height;
+  final Uint8List pixels;
+
+  FaixaCodigo(this.width, this.height, this.pixels);
+
+  // Warps the quadrilateral `cantos` (x, y of the top left, top right, bottom right and bottom left corners, in
+  // frame pixel coordinates) out of `frame` with a bilinear perspective warp. `margin` grows the quadrilateral around
+  // its center by that fraction on every side to keep the quiet zones in the evidence image.
+  static FaixaCodigo rectify(QuadroLuma frame, List<double> cantos,
+      {int height = 64, int maxWidth = 1024, double margin = 0.08}) {
+    var cx = (cantos[0] + cantos[2] + cantos[4] + cantos[6]) / 4;
+    var cy = (cantos[1] + cantos[3] + cantos[5] + cantos[7]) / 4;
+    var scale = 1 + 2 * margin;
+    var x0 = cx + (cantos[0] - cx) * scale, y0 = cy + (cantos[1] - cy) * scale;
+    var x1 = cx + (cantos[2] - cx) * scale, y1 = cy + (cantos[3] - cy) * scale;
+    var x2 = cx + (cantos[4] - cx) * scale, y2 = cy + (cantos[5] - cy) * scale;
+    var x3 = cx + (cantos[6] - cx) * scale, y3 = cy + (cantos[7] - cy) * scale;
+
+    // Keep the aspect ratio of the barcode, using the longer of the two opposite edges.
+    var across = math.max(_distance(x0, y0, x1, y1), _distance(x3, y3, x2, y2));
+    var along = math.max(_distance(x0, y0, x3, y3), _distance(x1, y1, x2, y2));
+    var width = along <= 0 ? height : (height * across / along).round();
+    if (width < 1) width = 1;
+    if (width > maxWidth) width = maxWidth;
+
+    var pixels = Uint8List(width * height);
+    _warp(frame, [x0, y0, x1, y1, x2, y2, x3, y3], width, height, pixels);
+    return FaixaCodigo(width, height, pixels);
+  }
+}
+
+// Maps the unit square onto the quadrilateral (Heckbert's projective mapping) and samples every destination pixel
+// center. Along a row the projective numerators and denominator are linear in u, so four neighbouring pixels are
+// evaluated at once with Float32x4 lanes and only the bilinear fetch is scalar.
+void _warp(QuadroLuma frame, List<double> q, int width, int height, Uint8List out) {
+  var dx1 = q[2] - q[4], dx2 = q[6] - q[4], dx3 = q[0] - q[2] + q[4] - q[6];
+  var dy1 = q[3] - q[5], dy2 = q[7] - q[5], dy3 = q[1] - q[3] + q[5] - q[7];
+  var den = dx1 * dy2 - dx2 * dy1;
+  var g = den == 0 ? 0.0 : (dx3 * dy2 - dx2 * dy3) / den;
+  var h = den == 0 ? 0.0 : (dx1 * dy3 - dx3 * dy1) / den;
+  var a = q[2] - q[0] + g * q[2], b = q[6] - q[0] + h * q[6], c = q[0];
+  var d = q[3] - q[1] + g * q[3], e = q[7] - q[1] + h * q[7], f = q[1];
+
+  var src = frame.data;
+  var srcWidth = frame.width;
+  var maxX = frame.width - 1.001;
+  var maxY = frame.height - 1.001;
+
+  var du = 1 / width;
+  var lanes = Float32x4(0.5, 1.5, 2.5, 3.5);
+  var step = Float32x4.splat(4 * du);
+  var a4 = Float32x4.splat(a), d4 = Float32x4.splat(d), g4 = Float32x4.splat(g);
+  var lo = Float32x4.zero();
+  var hiX = Float32x4.splat(maxX), hiY = Float32x4.splat(maxY);
+
+  for (var row = 0; row < height; row++) {
+    var v = (row + 0.5) / height;
+    var bx = Float32x4.splat(b * v + c), by = Float32x4.splat(e * v + f), bw = Float32x4.splat(h * v + 1);
+    var u = lanes.scale(du);
+    var base = row * width;
+    for (var col = 0; col < width; col += 4, u += step) {
+      var w = g4 * u + bw;
+      var xs = ((a4 * u + bx) / w).clamp(lo, hiX);
+      var ys = ((d4 * u + by) / w).clamp(lo, hiY);
+      var remaining = width - col;
+      out[base + col] = _bilinear(src, srcWidth, xs.x, ys.x);
+      if (remaining > 1) out[base + col + 1] = _bilinear(src, srcWidth, xs.y, ys.y);
+      if (remaining > 2) out[base + col + 2] = _bilinear(src, srcWidth, xs.z, ys.z);
+      if (remaining > 3) out[base + col + 3] = _bilinear(src, srcWidth, xs.w, ys.w);
+    }
+  }
+}
+
+int _bilinear(Uint8List src, int stride, double x, double y) {
+  var ix = x.toInt(), iy = y.toInt();
+  var fx = x - ix, fy = y - iy;
+  var i = iy * stride + ix;
+  var top = src[i] + (src[i + 1] - src[i]) * fx;
+  var bottom = src[i + stride] + (src[i + stride + 1] - src[i + stride]) * fx;
+  return (top + (bottom - top) * fy + 0.5).toInt();
+}
+
+double _distance(double ax, double ay, double bx, double by) {
+  var dx = ax - bx, dy = ay - by;
+  return math.sqrt(dx * dx + dy * dy);
+}
+
+// Minimal 8-bit grayscale PNG writer, run on a background isolate with compute() by the scanner screen. Rows use the
+// "Up" filter: barcode bars are vertical, so consecutive rows of a rectified strip are nearly identical and filter
+// down to long runs of zeros that deflate to a few kilobytes.
+Uint8List codificarPngCinza(FaixaCodigo strip) {
+  var width = strip.width, height = strip.height, pixels = strip.pixels;
+  var filtered = Uint8List((width + 1) * height);
+  for (var row = 0, o = 0; row < height; row++) {
+    var p = row * width;
+    if (row == 0) {
+      filtered[o++] = 0;
+      filtered.setRange(o, o + width, pixels, p);
+      o += width;
+    } else {
+      filtered[o++] = 2;
+      for (var col = 0; col < width; col++) {
+        filtered[o++] = (pixels[p + col] - pixels[p + col - width]) & 0xff;
+      }
+    }
+  }
+
+  var header = ByteData(13)
+    ..setUint32(0, width)
+    ..setUint32(4, height)
+    ..setUint8(8, 8) // bit depth
+    ..setUint8(9, 0); // grayscale, default compression/filter/interlace
+
+  var idat = ZLibEncoder(level: 9).convert(filtered);
+  var out = Uint8List(8 + 12 + 13 + 12 + idat.length + 12)
+    ..setAll(0, const [0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a]);
+  var offset = _writeChunk(out, 8, 0x49484452, header.buffer.asUint8List()); // IHDR
+  offset = _writeChunk(out, offset, 0x49444154, idat); // IDAT
+  _writeChunk(out, offset, 0x49454e44, const []); // IEND
+  return out;
+}
+
+// Writes length, type, data and CRC of one chunk at `offset` and returns the offset just past it.
+int _writeChunk(Uint8List out, int offset, int type, List<int> data) {
+  var view = ByteData.view(out.buffer);
+  view
+    ..setUint32(offset, data.length)
+    ..setUint32(offset + 4, type);
+  out.setAll(offset + 8, data);
+  var crc = _crc32(out, offset + 4, offset + 8 + data.length);
+  view.setUint32(offset + 8 + data.length, crc);
+  return offset + 12 + data.length;
+}
+
+final Uint32List _crcTable = () {
+  var table = Uint32List(256);
+  for (var n = 0; n < 256; n++) {
+    var c = n;
+    for (var k = 0; k < 8; k++) {
+      c = (c & 1) != 0 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+    }
+    table[n] = c;
+  }
+  return table;
+}();
+
+int _crc32(Uint8List data, int start, int end) {
+  var crc = 0xffffffff;
+  for (var i = start; i < end; i++) {
+    crc = _crcTable[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc ^ 0xffffffff;
+}
@@ -0,0 +1,94 @@
+import 'package:flutter/foundation.dart';
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+import 'ajuste_camera.dart';
+
+enum PoliticaCamera {
+  // Camera off while paused and the recommended resolution at all times, as before.
+  fixa,
+
+  // Standby while paused, so resuming does not reopen the camera; resolution as recommended.
+  standby,
+
+  // Standby while paused, HD while nothing is in view, Full HD with a near focus range once a barcode is localized.
+  adaptativa,
+}
+
+// Decides the camera state and resolution. Idle scanning at HD needs roughly half the pixels of Full HD per frame;
+// the boost to Full HD is kept for `tempoParaOcioso` after the last localized barcode, since every change of
+// resolution briefly restarts the stream. It is a duration rather than a frame count since the sessions reach the
+// governor rate-limited (see LimitadorSessao).
+//
+// The idle baseline is taken from `settings` when the governor is built. Settings tuned for the device (see
+// ajuste_camera.dart) load asynchronously, so they are handed over with adotarAjuste once they are in; until then,
+// or if they never load, the governor works from the recommended settings.
+class GovernadorCamera {
+  final Camera camera;
+  final CameraSettings settings;
+  final PoliticaCamera politica;
+  final Duration tempoParaOcioso;
+  VideoResolution resolucaoOciosa;
+
+  FocusRange _focusRangeOcioso;
+  bool _reforcado = false;
+  final Stopwatch _relogio = Stopwatch()..start();
+
+  // Microseconds on _relogio since the last frame with a barcode in view while boosted, -1 while one is in view.
+  int _semBarcodeDesde = -1;
+  final Stopwatch _retomada = Stopwatch();
+
+  GovernadorCamera(this.camera, this.settings,
+      {this.politica = PoliticaCamera.adaptativa,
+      this.tempoParaOcioso = const Duration(seconds: 3),
+      this.resolucaoOciosa = VideoResolution.hd})
+      : _focusRangeOcioso = settings.focusRange {
+    if (politica == PoliticaCamera.adaptativa) settings.preferredResolution = resolucaoOciosa;
+  }
+
+  // Takes the resolution and focus range of `ajuste` as the idle baseline; `ajuste` must already be applied to
+  // `settings`. The caller applies the settings to the camera afterwards.
+  void adotarAjuste(ConfiguracaoCamera ajuste) {
+    if (ajuste.resolucao != null) resolucaoOciosa = ajuste.resolucao!;
+    if (ajuste.focusRange != null) _focusRangeOcioso = ajuste.focusRange!;
+    if (politica != PoliticaCamera.adaptativa) return;
+    settings.preferredResolution = _reforcado ? VideoResolution.fullHd : resolucaoOciosa;
+    settings.focusRange = _reforcado ? FocusRange.near : _focusRangeOcioso;
+  }
+
+  // Debug builds log the time the camera took to report it was on.
+  Future<void> retomar() async {
+    _retomada
+      ..reset()
+      ..start();
+    await camera.switchToDesiredState(FrameSourceState.on);
+    _retomada.stop();
+    if (kDebugMode) debugPrint('Camera on ${_retomada.elapsedMilliseconds} ms after resuming');
+  }
+
+  Future<void> pausar() async {
+    if (politica == PoliticaCamera.adaptativa && _reforcado) _aplicar(false);
+    var estado = politica == PoliticaCamera.fixa ? FrameSourceState.off : FrameSourceState.standby;
+    await camera.switchToDesiredState(estado);
+  }
+
+  // Called with the sessions of processed frames, whether a barcode was localized or recognized in that frame.
+  void atualizar(bool barcodeEmVista) {
+    if (politica != PoliticaCamera.adaptativa) return;
+    if (barcodeEmVista) {
+      _semBarcodeDesde = -1;
+      if (!_reforcado) _aplicar(true);
+    } else if (_reforcado) {
+      var agora = _relogio.elapsedMicroseconds;
+      if (_semBarcodeDesde < 0) _semBarcodeDesde = agora;
+      if (agora - _semBarcodeDesde >= tempoParaOcioso.inMicroseconds) _aplicar(false);
+    }
+  }
+
+  void _aplicar(bool reforcado) {
+    _reforcado = reforcado;
+    _semBarcodeDesde = -1;
+    settings.preferredResolution = reforcado ? VideoResolution.fullHd : resolucaoOciosa;
+    settings.focusRange = reforcado ? FocusRange.near : _focusRangeOcioso;
+    camera.applySettings(settings);
+  }
+}
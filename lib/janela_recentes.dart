@@ -0,0 +1,22 @@
+import 'dart:collection';
+
+// Codes shown recently that the boleto cache does not cover, by key. Once the mode is enabled again after a dialog is
+// closed, the engine reports the codes still in view on the next frame; a key seen again within `janela` of its last
+// sighting is such a code and is not shown again.
+class JanelaRecentes {
+  final Duration janela;
+  final int capacidade;
+
+  // Keys in last-seen order, so the one not seen for the longest time is evicted first.
+  final LinkedHashMap<String, DateTime> _vistas = LinkedHashMap<String, DateTime>();
+
+  JanelaRecentes(this.janela, {this.capacidade = 64}) : assert(capacidade > 0);
+
+  // Records `chave` as seen at `agora` and returns whether it had already been seen within the window.
+  bool repetida(String chave, DateTime agora) {
+    var anterior = _vistas.remove(chave);
+    _vistas[chave] = agora;
+    if (_vistas.length > capacidade) _vistas.remove(_vistas.keys.first);
+    return anterior != null && agora.difference(anterior) <= janela;
+  }
+}
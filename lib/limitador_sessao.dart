@@ -0,0 +1,29 @@
+// Rate limit for the work done in didUpdateSession. The plugin delivers a session for every processed frame and
+// offers no way to unsubscribe from these callbacks while keeping didScan, so the listener drops the ones it does not
+// need here: at most one in `intervaloFrames` frames and none closer than `intervaloMinimo` to the previous one. The
+// assist and the governor it feeds measure their thresholds in time, not in sessions, so the rate does not change
+// how soon they react.
+class LimitadorSessao {
+  final int intervaloFrames;
+  final Duration intervaloMinimo;
+  bool ativo;
+
+  final Stopwatch _relogio = Stopwatch()..start();
+  int _ultimoFrame = -1;
+  int _ultimoMicros = 0;
+
+  LimitadorSessao(
+      {this.intervaloFrames = 2, this.intervaloMinimo = const Duration(milliseconds: 50), this.ativo = true});
+
+  bool deveProcessar(int frameSequenceId) {
+    if (!ativo) return false;
+    var agora = _relogio.elapsedMicroseconds;
+    if (_ultimoFrame >= 0 &&
+        (frameSequenceId - _ultimoFrame < intervaloFrames || agora - _ultimoMicros < intervaloMinimo.inMicroseconds)) {
+      return false;
+    }
+    _ultimoFrame = frameSequenceId;
+    _ultimoMicros = agora;
+    return true;
+  }
+}
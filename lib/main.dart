@@ -4,14 +4,43 @@
  * Copyright (C) 2020- Scandit AG. All rights reserved.
  */
 
+import 'dart:convert';
+import 'dart:io' show File;
+import 'dart:typed_data';
+
 import 'package:flutter/cupertino.dart';
 import 'package:flutter/material.dart';
+import 'package:flutter/services.dart';
 import 'package:flutter_platform_widgets/flutter_platform_widgets.dart';
+import 'package:path_provider/path_provider.dart';
 import 'package:permission_handler/permission_handler.dart';
 import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode.dart';
 import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode_capture.dart';
 import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
 
+import 'ajuste_camera.dart';
+import 'anel_quadros.dart';
+import 'arrecadacao.dart';
+import 'assistencia_zoom.dart';
+import 'barra_compacta.dart';
+import 'boleto.dart';
+import 'busca_ngram.dart';
+import 'cache_boletos.dart';
+import 'consenso.dart';
+import 'correcao.dart';
+import 'costura.dart';
+import 'diario_leituras.dart';
+import 'faixa_codigo.dart';
+import 'governador_camera.dart';
+import 'janela_recentes.dart';
+import 'limitador_sessao.dart';
+import 'modo_contagem.dart';
+import 'modo_mesa.dart';
+import 'perfis_captura.dart';
+import 'pix.dart';
+import 'tela_historico.dart';
+import 'vencimento.dart';
+
 void main() async {
   WidgetsFlutterBinding.ensureInitialized();
   await ScanditFlutterDataCaptureBarcode.initialize();
@@ -46,17 +75,72 @@ class _BarcodeScannerScreenState extends State<BarcodeScannerScreen>
   late BarcodeCapture _barcodeCapture;
   late DataCaptureView _captureView;
 
-  bool _isPermissionMessageVisible = false;
+  // Precompiled capture settings per profile; switching applies them to the running mode.
+  final Map<PerfilCaptura, BarcodeCaptureSettings> _perfis = compilarPerfis();
+  final ValueNotifier<PerfilCaptura> _perfil = ValueNotifier(PerfilCaptura.boleto);
+  final CameraSettings _cameraSettings = BarcodeCapture.recommendedCameraSettings;
+
+  // Moves the point of interest and zooms in on a boleto that is localized but does not decode.
+  AssistenciaZoom? _assistencia;
+
+  // Camera state on pause/resume and resolution depending on whether a barcode is in view.
+  GovernadorCamera? _governador;
+
+  // The assist and the governor do not need every frame's session.
+  final LimitadorSessao _limitadorSessao = LimitadorSessao();
+
+  // Only the permission message listens to this, so a permission change does not rebuild the capture view.
+  final ValueNotifier<bool> _isPermissionMessageVisible = ValueNotifier(false);
+
+  // Last known permission state. When it was granted, resuming starts the camera without waiting for the re-check.
+  bool _isPermissionGranted = false;
+
+  // Time from the last resume to the first frame with a recognized barcode, logged in debug builds next to the time
+  // the governor took to turn the camera back on.
+  final Stopwatch _resumeStopwatch = Stopwatch();
+
+  // Recently converted boletos. Repeats are answered from the cache and flagged as duplicates; a boleto seen again
+  // within a few seconds is the same one still in view after its dialog was closed and is not shown again.
+  final CacheBoletos _cacheBoletos = CacheBoletos();
+  static const Duration _recentWindow = Duration(seconds: 10);
+
+  // Pix QR codes and arrecadação barcodes shown recently, by value, with the same window as the boletos.
+  final JanelaRecentes _pixRecentes = JanelaRecentes(_recentWindow);
+  final JanelaRecentes _arrecadacoesRecentes = JanelaRecentes(_recentWindow);
+
+  // Reads failing the check digit are voted on across a few frames before they are reported.
+  final ConsensoLeituras _consenso = ConsensoLeituras(ParametrosConsenso.rapido);
+
+  // Partial reads of a damaged barcode (fewer than 44 digits) are stitched together across frames.
+  final CosturaParcial _costura = CosturaParcial();
+
+  // Last few 44-digit ITF reads, used to rank corrections of a read whose check digit does not match.
+  final List<Uint8List> _recentReads = [];
+  static const int _maxRecentReads = 8;
+
+  // Frames kept for audit. The frame of a journaled boleto stays pinned while its dialog is shown, and the boleto's
+  // strip is stored from it, see _guardarEvidencia.
+  final AnelQuadrosLuma _quadros = AnelQuadrosLuma();
+
+  // Every valid boleto shown to the user, for the history screen. It lives in memory until the journal file is loaded,
+  // see _openJournal.
+  DiarioLeituras _journal = DiarioLeituras();
+  late IndiceNGram _indiceNGram = IndiceNGram(_journal);
 
   _BarcodeScannerScreenState(this._context);
 
   void _checkPermission() {
-    Permission.camera.request().isGranted.then((value) => setState(() {
-          _isPermissionMessageVisible = !value;
-          if (value) {
-            _camera?.switchToDesiredState(FrameSourceState.on);
-          }
-        }));
+    if (_isPermissionGranted) _governador?.retomar();
+    Permission.camera.request().isGranted.then((value) {
+      var wasGranted = _isPermissionGranted;
+      _isPermissionGranted = value;
+      _isPermissionMessageVisible.value = !value;
+      if (value && !wasGranted) {
+        _governador?.retomar();
+      } else if (!value) {
+        _camera?.switchToDesiredState(FrameSourceState.off);
+      }
+    });
   }
 
   @override
@@ -64,8 +148,13 @@ class _BarcodeScannerScreenState extends State<BarcodeScannerScreen>
     super.initState();
     _ambiguate(WidgetsBinding.instance)?.addObserver(this);
 
-    // Use the recommended camera settings for the BarcodeCapture mode.
-    _camera?.applySettings(BarcodeCapture.recommendedCameraSettings);
+    // Use the recommended camera settings for the BarcodeCapture mode, adjusted by the governor, with the tuned ones
+    // on top once they are loaded. The governor exists from the start, so pausing before the tuned settings are in
+    // still switches the camera off or to standby.
+    if (_camera != null) _governador = GovernadorCamera(_camera!, _cameraSettings);
+    _camera?.applySettings(_cameraSettings);
+    _loadCameraSettings();
+    _openJournal();
 
     // Switch camera on to start streaming frames and enable the barcode tracking mode.
     // The camera is started asynchronously and will take some time to completely turn on.
@@ -73,24 +162,8 @@ class _BarcodeScannerScreenState extends State<BarcodeScannerScreen>
 
     // The barcode capture process is configured through barcode capture settings
     // which are then applied to the barcode capture instance that manages barcode capture.
-    var captureSettings = BarcodeCaptureSettings();
-
-    // The settings instance initially has all types of barcodes (symbologies) disabled. For the purpose of this
-    // sample we enable a very generous set of symbologies. In your own app ensure that you only enable the
-    // symbologies that your app requires as every additional enabled symbology has an impact on processing times.
-    captureSettings.enableSymbologies({
-      Symbology.interleavedTwoOfFive
-    });
-
-    // Some linear/1d barcode symbologies allow you to encode variable-length data. By default, the Scandit
-    // Data Capture SDK only scans barcodes in a certain length range. If your application requires scanning of one
-    // of these symbologies, and the length is falling outside the default range, you may need to adjust the "active
-    // symbol counts" for this symbology. This is shown in the following few lines of code for one of the
-    // variable-length symbologies.
-    captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).activeSymbolCounts =
-        [for (var i = 40; i <= 50; i++) i].toSet();
-
-    captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).setExtensionEnabled("strict", enabled: true);
+    // The settings of every profile are built up front, see perfis_captura.dart.
+    var captureSettings = _perfis[_perfil.value]!;
 
     // Create new barcode capture mode with the settings from above.
     _barcodeCapture = BarcodeCapture.forContext(_context, captureSettings)
@@ -114,6 +187,10 @@ class _BarcodeScannerScreenState extends State<BarcodeScannerScreen>
 
     _captureView.addOverlay(overlay);
 
+    if (_camera != null) {
+      _assistencia = AssistenciaZoom(_camera!, _captureView, _cameraSettings);
+    }
+
     // Set the default camera as the frame source of the context. The camera is off by
     // default and must be turned on to start streaming frames to the data capture context for recognition.
     if (_camera != null) {
@@ -123,39 +200,186 @@ class _BarcodeScannerScreenState extends State<BarcodeScannerScreen>
     _barcodeCapture.isEnabled = true;
   }
 
+  // Settings picked by the camera tuner (see ajuste_camera.dart), applied on top of the recommended ones and handed to
+  // the governor as its idle baseline. A missing or malformed asset keeps the recommended settings.
+  Future<void> _loadCameraSettings() async {
+    ConfiguracaoCamera ajuste;
+    try {
+      var json = await rootBundle.loadString('assets/camera_settings.json');
+      ajuste = ConfiguracaoCamera.fromJson(jsonDecode(json) as Map<String, dynamic>);
+    } catch (_) {
+      return;
+    }
+    if (!mounted) return;
+    ajuste.aplicarEm(_cameraSettings);
+    _governador?.adotarAjuste(ajuste);
+    await _camera?.applySettings(_cameraSettings);
+  }
+
+  // Loads the scan history kept in the app's support directory. Boletos scanned while it loads are carried over.
+  Future<void> _openJournal() async {
+    var directory = await getApplicationSupportDirectory();
+    var journal = await DiarioLeituras.abrir('${directory.path}/scan_journal.bin');
+    if (!mounted) {
+      await journal.fechar();
+      return;
+    }
+    for (var i = 0; i < _journal.length; i++) {
+      journal.add(_journal.barcodeAt(i), _journal.momentoAt(i));
+    }
+    _journal = journal;
+    _indiceNGram = IndiceNGram(journal);
+  }
+
   @override
   Widget build(BuildContext context) {
-    Widget child;
-    if (_isPermissionMessageVisible) {
-      child = PlatformText('No permission to access the camera!',
-          style: TextStyle(fontSize: 14, fontWeight: FontWeight.bold, color: Colors.black));
-    } else {
-      child = _captureView;
-    }
-    return Center(child: child);
+    return PlatformScaffold(
+      appBar: PlatformAppBar(
+        title: PlatformText('Boletos'),
+        trailingActions: [
+          ValueListenableBuilder<PerfilCaptura>(
+            valueListenable: _perfil,
+            builder: (_, perfil, __) =>
+                PlatformTextButton(child: PlatformText(nomesPerfis[perfil]!), onPressed: _switchProfile),
+          ),
+          PlatformIconButton(icon: Icon(Icons.view_module), onPressed: () => _open(TelaModoMesa(_context, _camera))),
+          PlatformIconButton(
+              icon: Icon(Icons.format_list_numbered), onPressed: () => _open(TelaContagem(_context, _camera))),
+          PlatformIconButton(icon: Icon(Icons.history), onPressed: () => _open(TelaHistorico(_journal, _indiceNGram))),
+        ],
+      ),
+      body: Center(
+        child: ValueListenableBuilder<bool>(
+          valueListenable: _isPermissionMessageVisible,
+          builder: (_, isVisible, captureView) => isVisible
+              ? PlatformText('Sem permissão para acessar a câmera!',
+                  style: TextStyle(fontSize: 14, fontWeight: FontWeight.bold, color: Colors.black))
+              : captureView!,
+          child: _captureView,
+        ),
+      ),
+    );
+  }
+
+  // Cycles through the capture profiles without recreating the mode or stopping the camera. Debug builds log how long
+  // the switch took to apply.
+  Future<void> _switchProfile() async {
+    var perfil = PerfilCaptura.values[(_perfil.value.index + 1) % PerfilCaptura.values.length];
+    var stopwatch = Stopwatch()..start();
+    await _barcodeCapture.applySettings(_perfis[perfil]!);
+    if (kDebugMode) debugPrint('Profile ${nomesPerfis[perfil]} applied in ${stopwatch.elapsedMilliseconds} ms');
+    _perfil.value = perfil;
+  }
+
+  // Opens a screen that runs its own mode on the shared context and camera, and takes them back afterwards.
+  Future<void> _open(Widget screen) async {
+    _barcodeCapture.isEnabled = false;
+    _context.removeMode(_barcodeCapture);
+    await Navigator.of(context).push(platformPageRoute(context: context, builder: (_) => screen));
+    _context.addMode(_barcodeCapture);
+    await _camera?.applySettings(_cameraSettings);
+    _barcodeCapture.isEnabled = true;
   }
 
   @override
   void didChangeAppLifecycleState(AppLifecycleState state) {
     if (state == AppLifecycleState.resumed) {
+      _resumeStopwatch
+        ..reset()
+        ..start();
       _checkPermission();
     } else if (state == AppLifecycleState.paused) {
-      _camera?.switchToDesiredState(FrameSourceState.off);
+      _governador?.pausar();
     }
   }
 
   @override
   void didScan(BarcodeCapture barcodeCapture, BarcodeCaptureSession session) async {
+    if (_resumeStopwatch.isRunning) {
+      _resumeStopwatch.stop();
+      if (kDebugMode) debugPrint('First read ${_resumeStopwatch.elapsedMilliseconds} ms after resuming');
+    }
+
+    // Convert every barcode recognized in this frame, not only the first one, so that two boletos in view are
+    // reported together instead of one of them having to be rescanned.
+    var codes = session.newlyRecognizedBarcodes;
+    var now = DateTime.now();
+    var itfValues = <String>[];
+    var locations = <String, Quadrilateral>{};
+    var arrecadacoes = <DadosArrecadacao>[];
+    for (var code in codes.where((code) => code.symbology == Symbology.interleavedTwoOfFive)) {
+      var value = _barcodeValue(code);
+      // Arrecadação barcodes have their own check digits, which neither the votes nor the corrections know about.
+      // Like a boleto, one still in view after its dialog was closed is not shown again.
+      if (_perfil.value == PerfilCaptura.arrecadacao) {
+        if (!_arrecadacoesRecentes.repetida(value, now)) arrecadacoes.add(converterArrecadacao(value));
+        continue;
+      }
+      if (value.length < BarraCompacta.length) {
+        var stitched = _costura.adicionar(value, code.location, session.frameSequenceId);
+        if (stitched != null) {
+          itfValues.add(stitched);
+          locations[stitched] = code.location;
+        }
+        continue;
+      }
+      _rememberRead(value);
+      var accepted = _consenso.adicionar(value, code.location, session.frameSequenceId);
+      if (accepted != null) {
+        itfValues.add(accepted);
+        locations[accepted] = code.location;
+      }
+    }
+    var frameId = session.frameSequenceId;
+    var lookups = _cacheBoletos.converterTodos(itfValues, now: now);
+    var boletos = lookups.where(_isNew).toList();
+    if (kDebugMode && lookups.isNotEmpty) {
+      var consultas = _cacheBoletos.hits + _cacheBoletos.misses;
+      debugPrint('Boleto cache: ${(_cacheBoletos.hitRate * 100).toStringAsFixed(1)}% hits over $consultas lookups');
+    }
+    // The Pix QR code of a boleto that is still in view after its dialog was closed is dropped along with the boleto.
+    var suppressed = {
+      for (var lookup in lookups)
+        if (!_isNew(lookup)) lookup.boleto.valorCentavos
+    };
+    var pix = <DadosPix>[];
+    for (var code in codes.where((code) => code.symbology == Symbology.qr)) {
+      var value = _barcodeValue(code);
+      var payload = lerPix(value);
+      if (payload == null || _pixRecentes.repetida(value, now) || suppressed.contains(payload.valorCentavos)) continue;
+      pix.add(payload);
+    }
+    if (boletos.isEmpty && arrecadacoes.isEmpty && pix.isEmpty) return;
     _barcodeCapture.isEnabled = false;
-    var code = session.newlyRecognizedBarcodes.first;
-    var data = (code.data == null || code.data?.isEmpty == true) ? code.rawData : code.data;
-    data = calculaLinha(data!).toString();
-    var humanReadableSymbology = SymbologyDescription.forSymbology(code.symbology);
+    _assistencia?.restaurar();
+
+    // A Pix QR code read in the same frame as a boleto is shown with the boleto whose amount it carries.
+    var entries = <String>[];
+    for (var lookup in boletos) {
+      // Only boletos whose check digit matches are journaled: the history lists their digitable lines and the
+      // journal feeds the CNAB payment files.
+      var packed = lookup.boleto.packed;
+      if (packed != null && lookup.boleto.isValid) {
+        _journal.add(packed, now);
+        _quadros.pin(frameId);
+        var location = locations[lookup.boleto.barcode];
+        if (location != null) _guardarEvidencia(lookup.boleto.barcode, now, frameId, location);
+      }
+      var description = _describe(lookup);
+      var match = pix.indexWhere((payload) => payload.valorCentavos == lookup.boleto.valorCentavos);
+      if (match >= 0) description += '\n${_describePix(pix.removeAt(match))}';
+      entries.add(description);
+    }
+    entries.addAll(arrecadacoes.map(_describeArrecadacao));
+    entries.addAll(pix.map(_describePix));
+    var data = entries.join('\n\n');
+    var humanReadableSymbology =
+        codes.map((code) => SymbologyDescription.forSymbology(code.symbology).readableName).toSet().join(', ');
     await showPlatformDialog(
         context: context,
         builder: (_) => PlatformAlertDialog(
           content: PlatformText(
-            'Scanned: $data\n (${humanReadableSymbology.readableName})',
+            'Lido: $data\n ($humanReadableSymbology)',
             style: TextStyle(fontWeight: FontWeight.bold, fontSize: 16),
           ),
           actions: [
@@ -166,99 +390,103 @@ class _BarcodeScannerScreenState extends State<BarcodeScannerScreen>
                 })
           ],
         ));
+    _quadros.release(frameId);
     _barcodeCapture.isEnabled = true;
   }
 
-  @override
-  void didUpdateSession(BarcodeCapture barcodeCapture, BarcodeCaptureSession session) {}
-
-  @override
-  void dispose() {
-    _ambiguate(WidgetsBinding.instance)?.removeObserver(this);
-    _barcodeCapture.removeListener(this);
-    _barcodeCapture.isEnabled = false;
-    _camera?.switchToDesiredState(FrameSourceState.off);
-    _context.removeAllModes();
-    super.dispose();
+  // Rectifies the boleto's strip out of its frame, if the frame is still in the ring, and writes it as a PNG named
+  // after the barcode and the scan time, which are the journal entry's. The strip is copied out before the first
+  // await, while the frame is pinned, and encoded on a background isolate.
+  Future<void> _guardarEvidencia(String barcode, DateTime momento, int frameId, Quadrilateral location) async {
+    var frame = _quadros.frame(frameId);
+    if (frame == null) return;
+    var faixa = FaixaCodigo.rectify(frame, [
+      location.topLeft.x,
+      location.topLeft.y,
+      location.topRight.x,
+      location.topRight.y,
+      location.bottomRight.x,
+      location.bottomRight.y,
+      location.bottomLeft.x,
+      location.bottomLeft.y
+    ]);
+    var png = await compute(codificarPngCinza, faixa);
+    var directory = await getApplicationSupportDirectory();
+    var arquivo = File('${directory.path}/evidencias/${barcode}_${momento.millisecondsSinceEpoch}.png');
+    await arquivo.create(recursive: true);
+    await arquivo.writeAsBytes(png);
   }
 
-  T? _ambiguate<T>(T? value) => value;
-}
-
-//Configure functions to parse the Boleto -- https://bit.ly/3zct7Yn
-//-------------------------------------------------------------------
-String modulo10(String numero)  {
-  numero = numero.replaceAll(RegExp("[^0-9]"),"");
-  double soma  = 0;
-  double peso  = 2;
-  int contador = numero.length-1;
-  while (contador >= 0) {
-    double multiplicacao = (double.parse(numero.substring(contador,contador+1)) * peso);
-    if (multiplicacao >= 10) {multiplicacao = 1 + (multiplicacao-10);}
-    soma = soma + multiplicacao;
-    if (peso == 2) {
-      peso = 1;
-    } else {
-      peso = 2;
+  // A boleto seen again within the recent window is the same one still in view after its dialog was closed.
+  bool _isNew(ConsultaBoleto lookup) => !lookup.isDuplicate || lookup.sinceLastSeen > _recentWindow;
+
+  String _describe(ConsultaBoleto lookup) {
+    var boleto = lookup.boleto;
+    var banco = boleto.banco;
+    var description = banco == null ? boleto.linha : '${boleto.linha}\n${banco.codigoFormatado} - ${banco.nomeCurto}';
+    if (boleto.isValid) {
+      var vencimento = boleto.diaVencimento(diaDeDateTime(DateTime.now()));
+      if (vencimento >= 0) description += '\nVencimento: ${formatarData(dataDoDia(vencimento))}';
+      description += '\nValor: ${formatarValor(boleto.valorCentavos)}';
     }
-    contador = contador - 1;
+    var campoLivre = boleto.isValid ? boleto.campoLivre : null;
+    if (campoLivre != null && campoLivre.nossoNumero != null) {
+      description += '\nNosso número: ${campoLivre.nossoNumero}';
+      if (!campoLivre.digitosValidos) description += ' (dígito do campo livre não confere)';
+    }
+    var packed = boleto.packed;
+    if (!boleto.isValid && packed != null) {
+      var digits = packed.digitsInto(Uint8List(BarraCompacta.length));
+      var correcoes = ordenarCorrecoes(enumerarCorrecoes(digits), _recentReads);
+      description += '\nCorreções possíveis:';
+      for (var correcao in correcoes.take(3)) {
+        description += '\n${correcao.barcode.toLinhaDigitavel()}';
+      }
+    }
+    return lookup.isDuplicate ? '$description\n(já lido)' : description;
   }
-  double digito = 10 - (soma % 10);
-  if (digito == 10) digito = 0;
 
-  return digito.round().toString();
-}
-
-String modulo11Banco(String numero) {
-  numero = numero.replaceAll(RegExp("[^0-9]"),"");
-
-  double soma  = 0;
-  double peso  = 2;
-  double base  = 9;
-  int contador = numero.length - 1;
-  for (int i=contador; i >= 0; i--) {
-    soma = soma +  (double.parse(numero.substring(i,i+1)) * peso);
-    if (peso < base) {
-      peso++;
-    } else {
-      peso = 2;
-    }
+  void _rememberRead(String value) {
+    var packed = BarraCompacta.tryParse(value);
+    if (packed == null) return;
+    _recentReads.add(packed.digitsInto(Uint8List(BarraCompacta.length)));
+    if (_recentReads.length > _maxRecentReads) _recentReads.removeAt(0);
   }
-  num digito = 11 - (soma % 11);
-  if (digito >  9) digito = 0;
-  /* Utilizar o dígito 1(um) sempre que o resultado do cálculo padrão for igual a 0(zero), 1(um) ou 10(dez). */
-  if (digito == 0) digito = 1;
-  return digito.toString();
-}
 
-String calculaLinha(String barra)  {
-  String linha = barra.replaceAll("[^0-9]", "");
+  String _describeArrecadacao(DadosArrecadacao arrecadacao) {
+    if (!arrecadacao.isValid) return '${arrecadacao.linha}\n(dígito verificador não confere)';
+    var valor = arrecadacao.valorCentavos;
+    return valor == null ? arrecadacao.linha : '${arrecadacao.linha}\nValor: ${formatarValor(valor)}';
+  }
 
-  if (linha.length != 44) {
-    return ("A linha do Código de Barras está incompleta!"); // Error
+  String _describePix(DadosPix pix) {
+    var description = 'Pix: ${pix.chave ?? pix.url}';
+    if (pix.valorCentavos != null) description += '\nValor Pix: ${formatarValor(pix.valorCentavos!)}';
+    if (pix.txid != null) description += '\ntxid: ${pix.txid}';
+    return pix.crcValido ? description : '$description\n(CRC do Pix não confere)';
   }
 
-  String campo1 = linha.substring(0,4)+linha.substring(19,20)+'.'+linha.substring(20,24);
-  String campo2 = linha.substring(24,29)+'.'+linha.substring(29,34);
-  String campo3 = linha.substring(34,39)+'.'+linha.substring(39,44);
-  String campo4 = linha.substring(4,5); // Digito verificador
-  String campo5 = linha.substring(5,19); // Vencimento + Valor
+  String _barcodeValue(Barcode code) => ((code.data == null || code.data?.isEmpty == true) ? code.rawData : code.data)!;
 
-  var digito = modulo11Banco(  linha.substring(0,4)+linha.substring(5,44));
-  var digitoValAr = digito.split('.');
+  @override
+  void didUpdateSession(BarcodeCapture barcodeCapture, BarcodeCaptureSession session) {
+    if (!_limitadorSessao.deveProcessar(session.frameSequenceId)) return;
+    _assistencia?.atualizar(session.newlyLocalizedBarcodes);
+    _governador?.atualizar(session.newlyLocalizedBarcodes.isNotEmpty || session.newlyRecognizedBarcodes.isNotEmpty);
+  }
 
-  if (  digitoValAr[0] != campo4 ) {
-    return ("Digito verificador "+campo4+", o correto é "+digitoValAr[0]+"\nO sistema não altera automaticamente o dígito correto na quinta casa!"); //Error
+  @override
+  void dispose() {
+    _ambiguate(WidgetsBinding.instance)?.removeObserver(this);
+    _barcodeCapture.removeListener(this);
+    _barcodeCapture.isEnabled = false;
+    _camera?.switchToDesiredState(FrameSourceState.off);
+    _context.removeAllModes();
+    _isPermissionMessageVisible.dispose();
+    _perfil.dispose();
+    _journal.fechar();
+    super.dispose();
   }
 
-  return   campo1 + modulo10(campo1)
-      +' '
-      +campo2 + modulo10(campo2)
-      +' '
-      +campo3 + modulo10(campo3)
-      +' '
-      +campo4
-      +' '
-      +campo5
-  ;
-}
\ No newline at end of file
+  T? _ambiguate<T>(T? value) => value;
+}
@@ -0,0 +1,121 @@
+import 'package:flutter/material.dart';
+import 'package:flutter_platform_widgets/flutter_platform_widgets.dart';
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode.dart';
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode_capture.dart';
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+import 'barra_compacta.dart';
+import 'boleto.dart';
+import 'totais_boletos.dart';
+
+// Counts a stack of boletos: every distinct barcode read while the stack is leafed through in front of the camera
+// is counted once, with the total amount and the number of barcodes whose check digit does not match. Reads are
+// deduplicated by their packed value before anything else is done with them, so a boleto that stays in view costs
+// one parse per frame and nothing more.
+class TelaContagem extends StatefulWidget {
+  final DataCaptureContext dataCaptureContext;
+  final Camera? camera;
+
+  TelaContagem(this.dataCaptureContext, this.camera);
+
+  @override
+  State<StatefulWidget> createState() => _TelaContagemState();
+}
+
+class _TelaContagemState extends State<TelaContagem> implements BarcodeCaptureListener {
+  late BarcodeCapture _barcodeCapture;
+  late DataCaptureView _captureView;
+
+  final ConjuntoBarras _contados = ConjuntoBarras(64);
+  final ConjuntoBarras _invalidos = ConjuntoBarras(16);
+  int _valorCentavos = 0;
+  final ValueNotifier<TotaisBoletos> _totals = ValueNotifier(const TotaisBoletos(0, 0, 0));
+  final ValueNotifier<String> _ultimaLinha = ValueNotifier('');
+
+  @override
+  void initState() {
+    super.initState();
+    widget.camera?.applySettings(BarcodeCapture.recommendedCameraSettings);
+
+    var captureSettings = BarcodeCaptureSettings()..enableSymbology(Symbology.interleavedTwoOfFive, true);
+    captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).activeSymbolCounts = {44};
+
+    _barcodeCapture = BarcodeCapture.forContext(widget.dataCaptureContext, captureSettings)..addListener(this);
+    _captureView = DataCaptureView.forContext(widget.dataCaptureContext);
+    _captureView.addOverlay(BarcodeCaptureOverlay.withBarcodeCaptureForViewWithStyle(
+        _barcodeCapture, _captureView, BarcodeCaptureOverlayStyle.frame));
+    _barcodeCapture.isEnabled = true;
+  }
+
+  @override
+  void didScan(BarcodeCapture barcodeCapture, BarcodeCaptureSession session) {
+    var mudou = false;
+    for (var code in session.newlyRecognizedBarcodes) {
+      var packed = BarraCompacta.tryParse(code.data ?? '');
+      if (packed == null || _contados.contains(packed) || _invalidos.contains(packed)) continue;
+      if (packed.hasValidDv) {
+        _contados.add(packed);
+        _valorCentavos += packed.valorCentavos;
+        _ultimaLinha.value = packed.toLinhaDigitavel();
+      } else {
+        _invalidos.add(packed);
+      }
+      mudou = true;
+    }
+    if (mudou) _totals.value = TotaisBoletos(_contados.length, _valorCentavos, _invalidos.length);
+  }
+
+  @override
+  void didUpdateSession(BarcodeCapture barcodeCapture, BarcodeCaptureSession session) {}
+
+  void _reset() {
+    _contados.clear();
+    _invalidos.clear();
+    _valorCentavos = 0;
+    _totals.value = const TotaisBoletos(0, 0, 0);
+    _ultimaLinha.value = '';
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    return PlatformScaffold(
+      appBar: PlatformAppBar(
+        title: PlatformText('Contar pilha'),
+        trailingActions: [PlatformIconButton(icon: Icon(Icons.refresh), onPressed: _reset)],
+      ),
+      body: Stack(children: [
+        _captureView,
+        Align(
+          alignment: Alignment.bottomCenter,
+          child: Container(
+            color: Colors.white,
+            padding: EdgeInsets.all(12),
+            child: Column(mainAxisSize: MainAxisSize.min, children: [
+              ValueListenableBuilder<TotaisBoletos>(
+                valueListenable: _totals,
+                builder: (_, totals, __) => PlatformText(
+                    '${totals.boletos} boletos, ${formatarValor(totals.valorCentavos)}'
+                    '${totals.invalidos > 0 ? '\n${totals.invalidos} com dígito verificador inválido' : ''}',
+                    style: TextStyle(fontSize: 16, fontWeight: FontWeight.bold, color: Colors.black)),
+              ),
+              ValueListenableBuilder<String>(
+                valueListenable: _ultimaLinha,
+                builder: (_, linha, __) => PlatformText(linha, style: TextStyle(fontSize: 12, color: Colors.black)),
+              ),
+            ]),
+          ),
+        ),
+      ]),
+    );
+  }
+
+  @override
+  void dispose() {
+    _barcodeCapture.removeListener(this);
+    _barcodeCapture.isEnabled = false;
+    widget.dataCaptureContext.removeMode(_barcodeCapture);
+    _totals.dispose();
+    _ultimaLinha.dispose();
+    super.dispose();
+  }
+}
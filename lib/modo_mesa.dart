@@ -0,0 +1,124 @@
+import 'package:flutter/foundation.dart';
+import 'package:flutter/material.dart';
+import 'package:flutter_platform_widgets/flutter_platform_widgets.dart';
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode.dart';
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode_tracking.dart';
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+import 'barra_compacta.dart';
+import 'boleto.dart';
+import 'totais_boletos.dart';
+
+// Scans a desk full of boletos at once with barcode tracking instead of one dialog per boleto. Every tracked barcode
+// is converted once: new identifiers of a frame are converted together on a background isolate and kept in a
+// table by identifier. Totals count each barcode once even when it leaves the view and comes back with a new
+// identifier.
+class TelaModoMesa extends StatefulWidget {
+  final DataCaptureContext dataCaptureContext;
+  final Camera? camera;
+
+  TelaModoMesa(this.dataCaptureContext, this.camera);
+
+  @override
+  State<StatefulWidget> createState() => _TelaModoMesaState();
+}
+
+class _TelaModoMesaState extends State<TelaModoMesa> implements BarcodeTrackingListener {
+  late BarcodeTracking _barcodeTracking;
+  late DataCaptureView _captureView;
+
+  final Map<int, DadosBoleto> _boletosPorIdentificador = {};
+  final Set<int> _pendentes = {};
+  final ConjuntoBarras _contados = ConjuntoBarras(64);
+  final ConjuntoBarras _invalidos = ConjuntoBarras(16);
+  int _valorCentavos = 0;
+  final ValueNotifier<TotaisBoletos> _totals = ValueNotifier(const TotaisBoletos(0, 0, 0));
+
+  @override
+  void initState() {
+    super.initState();
+    widget.camera?.applySettings(BarcodeTracking.recommendedCameraSettings);
+
+    var trackingSettings = BarcodeTrackingSettings()..enableSymbology(Symbology.interleavedTwoOfFive, true);
+    trackingSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).activeSymbolCounts = {44};
+
+    _barcodeTracking = BarcodeTracking.forContext(widget.dataCaptureContext, trackingSettings)..addListener(this);
+    _captureView = DataCaptureView.forContext(widget.dataCaptureContext);
+    _captureView.addOverlay(BarcodeTrackingBasicOverlay.withBarcodeTrackingForViewWithStyle(
+        _barcodeTracking, _captureView, BarcodeTrackingBasicOverlayStyle.frame));
+    _barcodeTracking.isEnabled = true;
+  }
+
+  @override
+  void didUpdateSession(BarcodeTracking barcodeTracking, BarcodeTrackingSession session) {
+    var identificadores = <int>[];
+    var valores = <String>[];
+    for (var tracked in session.addedTrackedBarcodes) {
+      var identificador = tracked.identifier;
+      var value = tracked.barcode.data;
+      if (value == null || value.isEmpty || _boletosPorIdentificador.containsKey(identificador)) continue;
+      if (!_pendentes.add(identificador)) continue;
+      identificadores.add(identificador);
+      valores.add(value);
+    }
+    if (valores.isEmpty) return;
+
+    compute(_converterTodos, valores).then((boletos) {
+      if (!mounted) return;
+      for (var i = 0; i < boletos.length; i++) {
+        _pendentes.remove(identificadores[i]);
+        _adicionar(identificadores[i], boletos[i]);
+      }
+      _totals.value = TotaisBoletos(_contados.length, _valorCentavos, _invalidos.length);
+    });
+  }
+
+  void _adicionar(int identificador, DadosBoleto boleto) {
+    _boletosPorIdentificador[identificador] = boleto;
+    var packed = boleto.packed;
+    if (packed == null) return;
+    if (!boleto.isValid) {
+      _invalidos.add(packed);
+    } else if (_contados.add(packed)) {
+      _valorCentavos += packed.valorCentavos;
+    }
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    return PlatformScaffold(
+      appBar: PlatformAppBar(title: PlatformText('Modo mesa')),
+      body: Stack(children: [
+        _captureView,
+        Align(
+          alignment: Alignment.bottomCenter,
+          child: ValueListenableBuilder<TotaisBoletos>(
+            valueListenable: _totals,
+            builder: (_, totals, __) => Container(
+              color: Colors.white,
+              padding: EdgeInsets.all(12),
+              child: PlatformText(
+                  '${totals.boletos} boletos, ${formatarValor(totals.valorCentavos)}'
+                  '${totals.invalidos > 0 ? '\n${totals.invalidos} com dígito verificador inválido' : ''}',
+                  style: TextStyle(fontSize: 16, fontWeight: FontWeight.bold, color: Colors.black)),
+            ),
+          ),
+        ),
+      ]),
+    );
+  }
+
+  @override
+  void dispose() {
+    _barcodeTracking.removeListener(this);
+    _barcodeTracking.isEnabled = false;
+    widget.dataCaptureContext.removeMode(_barcodeTracking);
+    _totals.dispose();
+    super.dispose();
+  }
+}
+
+// Converts every value, one result per value and in the same order, on the background isolate. Repeated values are
+// converted again rather than dropped, which would shift the results against the identifiers when two tracked
+// barcodes carry the same data (the same boleto twice on the desk, or a barcode that reappeared with a new identifier).
+List<DadosBoleto> _converterTodos(List<String> valores) => [for (var valor in valores) converterBoleto(valor)];
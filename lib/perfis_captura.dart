@@ -0,0 +1,57 @@
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode.dart';
+import 'package:scandit_flutter_datacapture_barcode/scandit_flutter_datacapture_barcode_capture.dart';
+
+enum PerfilCaptura {
+  // Bank boletos, including the Pix QR code of a "boleto híbrido".
+  boleto,
+
+  // Utility and tax bills (arrecadação): a 44-digit ITF only.
+  arrecadacao,
+
+  // Pix QR codes only.
+  pix,
+}
+
+const Map<PerfilCaptura, String> nomesPerfis = {
+  PerfilCaptura.boleto: 'Boleto',
+  PerfilCaptura.arrecadacao: 'Arrecadação',
+  PerfilCaptura.pix: 'Pix',
+};
+
+// Builds the settings of every profile once, so switching only hands a ready settings instance to
+// BarcodeCapture.applySettings while the camera keeps streaming.
+Map<PerfilCaptura, BarcodeCaptureSettings> compilarPerfis() => {
+      for (var perfil in PerfilCaptura.values) perfil: _settingsPara(perfil),
+    };
+
+BarcodeCaptureSettings _settingsPara(PerfilCaptura perfil) {
+  var captureSettings = BarcodeCaptureSettings();
+
+  // The settings instance initially has all types of barcodes (symbologies) disabled. Each profile only enables the
+  // symbologies it needs, as every additional enabled symbology has an impact on processing times.
+  switch (perfil) {
+    case PerfilCaptura.boleto:
+      captureSettings.enableSymbologies({
+        Symbology.interleavedTwoOfFive,
+        // Pix QR code printed next to the barcode on "boletos híbridos".
+        Symbology.qr
+      });
+
+      // Some linear/1d barcode symbologies allow you to encode variable-length data. By default, the Scandit
+      // Data Capture SDK only scans barcodes in a certain length range. A boleto has 44 digits; the range around it
+      // lets damaged barcodes decode partially so that reads can be stitched together across frames.
+      captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).activeSymbolCounts =
+          [for (var i = 40; i <= 50; i++) i].toSet();
+      captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).setExtensionEnabled("strict", enabled: true);
+      break;
+    case PerfilCaptura.arrecadacao:
+      captureSettings.enableSymbology(Symbology.interleavedTwoOfFive, true);
+      captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).activeSymbolCounts = {44};
+      captureSettings.settingsForSymbology(Symbology.interleavedTwoOfFive).setExtensionEnabled("strict", enabled: true);
+      break;
+    case PerfilCaptura.pix:
+      captureSettings.enableSymbology(Symbology.qr, true);
+      break;
+  }
+  return captureSettings;
+}
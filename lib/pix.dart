@@ -0,0 +1,174 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+// Pix BR Code (EMV QR Code "Merchant-Presented Mode") as printed next to the ITF barcode on a "boleto híbrido".
+// The payload is a flat list of TLV fields (2-digit id, 2-digit length, value) with nested templates; the parser walks
+// it in place by offsets and only copies the few values it returns.
+class DadosPix {
+  final String? chave;
+  final String? url;
+  final int? valorCentavos;
+  final String? txid;
+  final String? nomeRecebedor;
+  final String? cidade;
+
+  // CRC16 in field 63 matches the payload.
+  final bool crcValido;
+
+  DadosPix(this.chave, this.url, this.valorCentavos, this.txid, this.nomeRecebedor, this.cidade, this.crcValido);
+}
+
+const String _pixGui = 'br.gov.bcb.pix';
+
+// Returns null when `payload` is not a well-formed Pix BR Code.
+DadosPix? lerPix(String payload) {
+  if (!payload.startsWith('000201')) return null;
+
+  String? chave, url, txid, nomeRecebedor, cidade;
+  int? valorCentavos;
+  var crcStart = -1;
+
+  var i = 0;
+  while (i < payload.length) {
+    var id = _twoDigits(payload, i);
+    var length = _twoDigits(payload, i + 2);
+    var start = i + 4, end = start + length;
+    if (id < 0 || length < 0 || end > payload.length) return null;
+
+    if (id >= 26 && id <= 51 && _isPixAccount(payload, start, end)) {
+      chave = _subfield(payload, start, end, 1) ?? chave;
+      url = _subfield(payload, start, end, 25) ?? url;
+    } else if (id == 54) {
+      valorCentavos = _parseValor(payload, start, end);
+    } else if (id == 59) {
+      nomeRecebedor = payload.substring(start, end);
+    } else if (id == 60) {
+      cidade = payload.substring(start, end);
+    } else if (id == 62) {
+      txid = _subfield(payload, start, end, 5);
+    } else if (id == 63) {
+      if (length != 4 || end != payload.length) return null;
+      crcStart = start;
+    }
+    i = end;
+  }
+  if (chave == null && url == null) return null;
+
+  var crcValido = crcStart >= 0 && _parseHex(payload, crcStart, crcStart + 4) == _crcOf(payload, crcStart);
+  return DadosPix(chave, url, valorCentavos, txid, nomeRecebedor, cidade, crcValido);
+}
+
+int _twoDigits(String s, int i) {
+  if (i + 2 > s.length) return -1;
+  var d0 = s.codeUnitAt(i) - 0x30, d1 = s.codeUnitAt(i + 1) - 0x30;
+  if (d0 < 0 || d0 > 9 || d1 < 0 || d1 > 9) return -1;
+  return d0 * 10 + d1;
+}
+
+// Finds sub-field `wanted` inside the template payload[start, end) and returns its value.
+String? _subfield(String s, int start, int end, int wanted) {
+  var i = start;
+  while (i + 4 <= end) {
+    var id = _twoDigits(s, i);
+    var length = _twoDigits(s, i + 2);
+    if (id < 0 || length < 0 || i + 4 + length > end) return null;
+    if (id == wanted) return s.substring(i + 4, i + 4 + length);
+    i += 4 + length;
+  }
+  return null;
+}
+
+// A merchant account template belongs to Pix when its sub-field 00 is the Pix GUI, compared case-insensitively.
+bool _isPixAccount(String s, int start, int end) {
+  if (end - start < 4 + _pixGui.length || _twoDigits(s, start) != 0 || _twoDigits(s, start + 2) != _pixGui.length) {
+    return false;
+  }
+  for (var k = 0; k < _pixGui.length; k++) {
+    if ((s.codeUnitAt(start + 4 + k) | 0x20) != _pixGui.codeUnitAt(k)) return false;
+  }
+  return true;
+}
+
+// Amount field: up to 13 characters such as "1234.56" or "10".
+int? _parseValor(String s, int start, int end) {
+  var reais = 0, centavos = 0, decimais = -1;
+  for (var i = start; i < end; i++) {
+    var c = s.codeUnitAt(i);
+    if (c == 0x2e && decimais < 0) {
+      decimais = 0;
+      continue;
+    }
+    var digit = c - 0x30;
+    if (digit < 0 || digit > 9 || decimais >= 2) return null;
+    if (decimais < 0) {
+      reais = reais * 10 + digit;
+    } else {
+      centavos = centavos * 10 + digit;
+      decimais++;
+    }
+  }
+  if (decimais == 1) centavos *= 10;
+  return reais * 100 + centavos;
+}
+
+int _parseHex(String s, int start, int end) {
+  var value = 0;
+  for (var i = start; i < end; i++) {
+    var c = s.codeUnitAt(i) | 0x20;
+    var nibble = c >= 0x30 && c <= 0x39 ? c - 0x30 : (c >= 0x61 && c <= 0x66 ? c - 0x61 + 10 : -1);
+    if (nibble < 0) return -1;
+    value = (value << 4) | nibble;
+  }
+  return value;
+}
+
+// The CRC covers the payload up to and including the "6304" prefix of the CRC field. Pix payloads are ASCII in
+// practice, in which case the code units are the bytes and nothing is copied.
+int _crcOf(String payload, int end) {
+  var units = payload.codeUnits;
+  for (var i = 0; i < end; i++) {
+    if (units[i] > 0x7f) return crc16Ccitt(utf8.encode(payload.substring(0, end)));
+  }
+  return crc16Ccitt(units, end);
+}
+
+// CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) with slice-by-8 tables: table k holds the CRC of a
+// byte followed by k zero bytes, so eight input bytes are folded in with eight lookups.
+int crc16Ccitt(List<int> data, [int? length]) {
+  var n = length ?? data.length;
+  var t = _crcTables;
+  var crc = 0xffff;
+  var i = 0;
+  for (; n - i >= 8; i += 8) {
+    crc = t[0x700 + (data[i] ^ (crc >> 8))] ^
+        t[0x600 + (data[i + 1] ^ (crc & 0xff))] ^
+        t[0x500 + data[i + 2]] ^
+        t[0x400 + data[i + 3]] ^
+        t[0x300 + data[i + 4]] ^
+        t[0x200 + data[i + 5]] ^
+        t[0x100 + data[i + 6]] ^
+        t[data[i + 7]];
+  }
+  for (; i < n; i++) {
+    crc = ((crc << 8) & 0xffff) ^ t[(crc >> 8) ^ data[i]];
+  }
+  return crc;
+}
+
+final Uint16List _crcTables = () {
+  var tables = Uint16List(8 * 256);
+  for (var b = 0; b < 256; b++) {
+    var c = b << 8;
+    for (var k = 0; k < 8; k++) {
+      c = (c & 0x8000) != 0 ? ((c << 1) ^ 0x1021) & 0xffff : (c << 1) & 0xffff;
+    }
+    tables[b] = c;
+  }
+  for (var k = 1; k < 8; k++) {
+    for (var b = 0; b < 256; b++) {
+      var previous = tables[(k - 1) * 256 + b];
+      tables[k * 256 + b] = ((previous << 8) & 0xffff) ^ tables[previous >> 8];
+    }
+  }
+  return tables;
+}();
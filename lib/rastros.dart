@@ -0,0 +1,91 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:scandit_flutter_datacapture_core/scandit_flutter_datacapture_core.dart';
+
+// A fixed number of tracks following barcodes across frames by location, shared by the stages that accumulate reads
+// per barcode (ConsensoLeituras, CosturaParcial); each keeps its own per-track counters indexed by track. A read
+// joins the active track whose last bounding box overlaps its own the most, with an intersection over union above
+// `sobreposicaoMinima`, provided that track was updated at most `maxIntervaloFrames` frames before.
+class RastrosLocalizacao {
+  final int tracks;
+  final int maxIntervaloFrames;
+  final double sobreposicaoMinima;
+
+  final Uint8List _ativo;
+  final Int64List _ultimoFrame;
+
+  // Bounding box of each track's last location as x0, y0, x1, y1.
+  final Float64List _caixas;
+
+  RastrosLocalizacao(this.tracks, this.maxIntervaloFrames, {this.sobreposicaoMinima = 0.3})
+      : _ativo = Uint8List(tracks),
+        _ultimoFrame = Int64List(tracks),
+        _caixas = Float64List(tracks * 4);
+
+  bool ativo(int track) => _ativo[track] != 0;
+
+  // The active track matching a read at `location` in `frame`, or -1.
+  int encontrar(Quadrilateral location, int frame) {
+    var melhor = -1;
+    var melhorSobreposicao = sobreposicaoMinima;
+    for (var track = 0; track < tracks; track++) {
+      if (_ativo[track] == 0 || frame - _ultimoFrame[track] > maxIntervaloFrames) continue;
+      var sobreposicao = _sobreposicao(track, location);
+      if (sobreposicao > melhorSobreposicao) {
+        melhor = track;
+        melhorSobreposicao = sobreposicao;
+      }
+    }
+    return melhor;
+  }
+
+  // The track a read at `location` in `frame` belongs to. When no track matches, an inactive one is taken, or else
+  // the one updated longest ago is evicted; either way it is returned inactive, and the caller resets its counters.
+  int trackPara(Quadrilateral location, int frame) {
+    var encontrado = encontrar(location, frame);
+    if (encontrado >= 0) return encontrado;
+
+    var escolhido = 0;
+    for (var track = 0; track < tracks; track++) {
+      if (_ativo[track] == 0) {
+        escolhido = track;
+        break;
+      }
+      if (_ultimoFrame[track] < _ultimoFrame[escolhido]) escolhido = track;
+    }
+    _ativo[escolhido] = 0;
+    return escolhido;
+  }
+
+  // Records a read added to `track`.
+  void atualizar(int track, Quadrilateral q, int frame) {
+    _ativo[track] = 1;
+    _ultimoFrame[track] = frame;
+    _caixas[track * 4] = _min4(q.topLeft.x, q.topRight.x, q.bottomRight.x, q.bottomLeft.x);
+    _caixas[track * 4 + 1] = _min4(q.topLeft.y, q.topRight.y, q.bottomRight.y, q.bottomLeft.y);
+    _caixas[track * 4 + 2] = _max4(q.topLeft.x, q.topRight.x, q.bottomRight.x, q.bottomLeft.x);
+    _caixas[track * 4 + 3] = _max4(q.topLeft.y, q.topRight.y, q.bottomRight.y, q.bottomLeft.y);
+  }
+
+  void desativar(int track) => _ativo[track] = 0;
+
+  // Intersection over union of the bounding boxes of the track's last location and `q`.
+  double _sobreposicao(int track, Quadrilateral q) {
+    var x0 = _min4(q.topLeft.x, q.topRight.x, q.bottomRight.x, q.bottomLeft.x);
+    var y0 = _min4(q.topLeft.y, q.topRight.y, q.bottomRight.y, q.bottomLeft.y);
+    var x1 = _max4(q.topLeft.x, q.topRight.x, q.bottomRight.x, q.bottomLeft.x);
+    var y1 = _max4(q.topLeft.y, q.topRight.y, q.bottomRight.y, q.bottomLeft.y);
+    var c = track * 4;
+    var largura = math.min(x1, _caixas[c + 2]) - math.max(x0, _caixas[c]);
+    var altura = math.min(y1, _caixas[c + 3]) - math.max(y0, _caixas[c + 1]);
+    if (largura <= 0 || altura <= 0) return 0;
+    var intersecao = largura * altura;
+    var uniao = (x1 - x0) * (y1 - y0) + (_caixas[c + 2] - _caixas[c]) * (_caixas[c + 3] - _caixas[c + 1]) - intersecao;
+    return uniao <= 0 ? 0 : intersecao / uniao;
+  }
+}
+
+double _min4(double a, double b, double c, double d) => math.min(math.min(a, b), math.min(c, d));
+
+double _max4(double a, double b, double c, double d) => math.max(math.max(a, b), math.max(c, d));
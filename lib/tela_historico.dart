@@ -0,0 +1,78 @@
+import 'package:flutter/material.dart';
+import 'package:flutter_platform_widgets/flutter_platform_widgets.dart';
+
+import 'boleto.dart';
+import 'busca_ngram.dart';
+import 'diario_leituras.dart';
+
+// Scan history with search by digitable line. The list is built lazily with a fixed item extent, so scrolling through
+// tens of thousands of entries lays out only the visible rows, and every keystroke runs one prefix lookup on the
+// journal's index. When no line starts with the typed digits, lines containing them with one digit wrong, missing or
+// extra are listed instead.
+class TelaHistorico extends StatefulWidget {
+  final DiarioLeituras journal;
+  final IndiceNGram indice;
+
+  TelaHistorico(this.journal, this.indice);
+
+  @override
+  State<StatefulWidget> createState() => _TelaHistoricoState();
+}
+
+class _TelaHistoricoState extends State<TelaHistorico> {
+  static const double _itemExtent = 64;
+
+  // Matching entries in display order; null lists the whole journal, newest first.
+  final ValueNotifier<List<int>?> _resultado = ValueNotifier(null);
+
+  void _buscar(String consulta) {
+    if (consulta.isEmpty) {
+      _resultado.value = null;
+      return;
+    }
+    var resultado = widget.journal.buscarPrefixo(consulta);
+    if (resultado.isEmpty) resultado = [for (var encontrado in widget.indice.buscar(consulta)) encontrado.indice];
+    _resultado.value = resultado;
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    var journal = widget.journal;
+    return PlatformScaffold(
+      appBar: PlatformAppBar(title: PlatformText('Histórico')),
+      body: Column(children: [
+        Padding(
+          padding: EdgeInsets.all(8),
+          child: PlatformTextField(keyboardType: TextInputType.number, hintText: 'Linha digitável', onChanged: _buscar),
+        ),
+        Expanded(
+          child: ValueListenableBuilder<List<int>?>(
+            valueListenable: _resultado,
+            builder: (_, resultado, __) => ListView.builder(
+              itemExtent: _itemExtent,
+              itemCount: resultado?.length ?? journal.length,
+              itemBuilder: (_, position) {
+                var index = resultado != null ? resultado[position] : journal.length - 1 - position;
+                var barcode = journal.barcodeAt(index);
+                return Padding(
+                  padding: EdgeInsets.symmetric(horizontal: 12, vertical: 8),
+                  child: Column(crossAxisAlignment: CrossAxisAlignment.start, children: [
+                    PlatformText(barcode.toLinhaDigitavel(), style: TextStyle(fontSize: 13, color: Colors.black)),
+                    PlatformText('${formatarValor(barcode.valorCentavos)} - ${journal.momentoAt(index)}',
+                        style: TextStyle(fontSize: 12, color: Colors.black54)),
+                  ]),
+                );
+              },
+            ),
+          ),
+        ),
+      ]),
+    );
+  }
+
+  @override
+  void dispose() {
+    _resultado.dispose();
+    super.dispose();
+  }
+}
@@ -0,0 +1,8 @@
+// Running totals of the boletos captured in desk or counting mode.
+class TotaisBoletos {
+  final int boletos;
+  final int valorCentavos;
+  final int invalidos;
+
+  const TotaisBoletos(this.boletos, this.valorCentavos, this.invalidos);
+}
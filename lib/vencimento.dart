@@ -0,0 +1,154 @@
+import 'dart:typed_data';
+
+// Due date calendar for the "fator de vencimento" (barcode positions 6-9): the number of days since 1997-10-07.
+// The factor reached 9999 on 2025-02-21 and restarted at 1000 on 2025-02-22, so a factor names two dates 9000 days
+// apart and is resolved to the one closest to a reference day.
+//
+// Days are plain integers counted from the base date ("dia"). The tables below cover both factor cycles and are
+// built once on first use: the civil date of every day packed as yyyymmdd and a bitmap of weekends and Brazilian
+// national banking holidays, so factor -> date and "next business day" are array reads without DateTime objects.
+
+const int diaBase = 0; // 1997-10-07
+const int diaReinicioFator = 10000; // 2025-02-22, first day of the second factor cycle
+const int totalDias = diaReinicioFator + 9000;
+
+// Day of 1970-01-01 relative to the base date.
+const int _diaEpoch = -10141;
+
+// Returns the day for a due date factor, or -1 for factor 0 (no due date) and factors outside 1-9999. `hoje` picks
+// the cycle when the factor is ambiguous.
+int diaDoFator(int fator, int hoje) {
+  if (fator <= 0 || fator > 9999) return -1;
+  if (fator < 1000) return fator;
+  var primeiro = fator;
+  var segundo = fator + 9000;
+  return (hoje - primeiro).abs() <= (segundo - hoje).abs() ? primeiro : segundo;
+}
+
+// Civil date of a day packed as yyyymmdd (e.g. 20250222), or 0 outside the table.
+int dataDoDia(int dia) => dia < 0 || dia >= totalDias ? 0 : _calendario.datas[dia];
+
+bool ehDiaUtil(int dia) => dia >= 0 && dia < totalDias && !_calendario.naoUtil(dia);
+
+bool ehFeriado(int dia) => dia >= 0 && dia < totalDias && _calendario.feriado(dia);
+
+// First business day on or after `dia`. Days outside the table are returned unchanged.
+int proximoDiaUtil(int dia) => dia < 0 || dia >= totalDias ? dia : dia + _calendario.ateProximoUtil[dia];
+
+// A boleto due on a weekend or holiday can be paid without charges on the next business day.
+bool pagavelSemEncargos(int vencimento, int pagamento) => pagamento <= proximoDiaUtil(vencimento);
+
+int diaDaData(int ano, int mes, int dia) => _diasDesdeEpoch(ano, mes, dia) + _diaEpoch;
+
+int diaDeDateTime(DateTime data) => diaDaData(data.year, data.month, data.day);
+
+String formatarData(int yyyymmdd) {
+  var dia = (yyyymmdd % 100).toString().padLeft(2, '0');
+  var mes = (yyyymmdd ~/ 100 % 100).toString().padLeft(2, '0');
+  return '$dia/$mes/${yyyymmdd ~/ 10000}';
+}
+
+// Days from 1970-01-01 to a proleptic Gregorian date (Howard Hinnant's days_from_civil).
+int _diasDesdeEpoch(int ano, int mes, int dia) {
+  var y = mes <= 2 ? ano - 1 : ano;
+  var era = y ~/ 400;
+  var anoDaEra = y - era * 400;
+  var diaDoAno = (153 * (mes > 2 ? mes - 3 : mes + 9) + 2) ~/ 5 + dia - 1;
+  var diaDaEra = anoDaEra * 365 + anoDaEra ~/ 4 - anoDaEra ~/ 100 + diaDoAno;
+  return era * 146097 + diaDaEra - 719468;
+}
+
+final _Calendario _calendario = _Calendario();
+
+class _Calendario {
+  final Int32List datas = Int32List(totalDias);
+  final Uint32List _naoUtil = Uint32List((totalDias + 31) >> 5);
+  final Uint32List _feriado = Uint32List((totalDias + 31) >> 5);
+  final Uint8List ateProximoUtil = Uint8List(totalDias);
+
+  _Calendario() {
+    const diasNoMes = [31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31];
+    var ano = 1997, mes = 10, diaDoMes = 7;
+    // 1997-10-07 was a Tuesday; 0 is Sunday.
+    var diaDaSemana = 2;
+    for (var dia = 0; dia < totalDias; dia++) {
+      datas[dia] = ano * 10000 + mes * 100 + diaDoMes;
+      if (diaDaSemana == 0 || diaDaSemana == 6) _marcar(_naoUtil, dia);
+
+      diaDaSemana = (diaDaSemana + 1) % 7;
+      var bissexto = ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0);
+      if (diaDoMes < diasNoMes[mes - 1] + (mes == 2 && bissexto ? 1 : 0)) {
+        diaDoMes++;
+      } else {
+        diaDoMes = 1;
+        if (++mes > 12) {
+          mes = 1;
+          ano++;
+        }
+      }
+    }
+
+    for (var anoFeriados = 1997; anoFeriados <= 2049; anoFeriados++) {
+      _feriadosNacionais(anoFeriados);
+    }
+
+    var ate = 0;
+    for (var dia = totalDias - 1; dia >= 0; dia--) {
+      ate = naoUtil(dia) ? ate + 1 : 0;
+      ateProximoUtil[dia] = ate;
+    }
+  }
+
+  bool naoUtil(int dia) => ((_naoUtil[dia >> 5] >> (dia & 31)) & 1) != 0;
+
+  bool feriado(int dia) => ((_feriado[dia >> 5] >> (dia & 31)) & 1) != 0;
+
+  void _marcar(Uint32List bitmap, int dia) {
+    if (dia >= 0 && dia < totalDias) bitmap[dia >> 5] |= 1 << (dia & 31);
+  }
+
+  void _feriadoEm(int ano, int mes, int dia) => _feriadoNoDia(diaDaData(ano, mes, dia));
+
+  void _feriadoNoDia(int dia) {
+    _marcar(_feriado, dia);
+    _marcar(_naoUtil, dia);
+  }
+
+  // National holidays on which banks do not open, including carnival Monday and Tuesday and Corpus Christi.
+  void _feriadosNacionais(int ano) {
+    _feriadoEm(ano, 1, 1);
+    _feriadoEm(ano, 4, 21);
+    _feriadoEm(ano, 5, 1);
+    _feriadoEm(ano, 9, 7);
+    _feriadoEm(ano, 10, 12);
+    _feriadoEm(ano, 11, 2);
+    _feriadoEm(ano, 11, 15);
+    if (ano >= 2024) _feriadoEm(ano, 11, 20);
+    _feriadoEm(ano, 12, 25);
+
+    var pascoa = _pascoa(ano);
+    _feriadoNoDia(pascoa - 48);
+    _feriadoNoDia(pascoa - 47);
+    _feriadoNoDia(pascoa - 2);
+    _feriadoNoDia(pascoa + 60);
+  }
+
+  // Easter Sunday (anonymous Gregorian algorithm) as a day number.
+  int _pascoa(int ano) {
+    var a = ano % 19;
+    var b = ano ~/ 100;
+    var c = ano % 100;
+    var d = b ~/ 4;
+    var e = b % 4;
+    var f = (b + 8) ~/ 25;
+    var g = (b - f + 1) ~/ 3;
+    var h = (19 * a + b - d - g + 15) % 30;
+    var i = c ~/ 4;
+    var k = c % 4;
+    var l = (32 + 2 * e + 2 * i - h - k) % 7;
+    var m = (a + 11 * h + 22 * l) ~/ 451;
+    var mes = (h + l - 7 * m + 114) ~/ 31;
+    var dia = (h + l - 7 * m + 114) % 31 + 1;
+    return diaDaData(ano, mes, dia);
+  }
+}
@@ -0,0 +1,88 @@
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/anel_quadros.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+// A width x height luma plane whose pixels all hold `valor`, with rows `stride` bytes apart.
+Uint8List _plano(int width, int height, int valor, {int? stride}) {
+  var plane = Uint8List((stride ?? width) * height);
+  for (var row = 0; row < height; row++) {
+    plane.fillRange(row * (stride ?? width), row * (stride ?? width) + width, valor);
+  }
+  return plane;
+}
+
+void main() {
+  test('a stored frame is returned as put, padded rows included', () {
+    var anel = AnelQuadrosLuma(capacity: 3, maxWidth: 8, maxHeight: 4);
+    var plane = Uint8List.fromList(List.generate(10 * 3, (i) => i));
+    expect(anel.put(1, plane, 6, 3, rowStride: 10), isTrue);
+    var frame = anel.frame(1)!;
+    expect([frame.frameId, frame.width, frame.height], [1, 6, 3]);
+    expect(frame.data, [0, 1, 2, 3, 4, 5, 10, 11, 12, 13, 14, 15, 20, 21, 22, 23, 24, 25]);
+  });
+
+  test('the oldest frame is overwritten when the ring wraps around', () {
+    var anel = AnelQuadrosLuma(capacity: 3, maxWidth: 4, maxHeight: 4);
+    for (var id = 0; id < 5; id++) {
+      expect(anel.put(id, _plano(4, 4, id), 4, 4), isTrue);
+    }
+    expect(anel.frame(0), isNull);
+    expect(anel.frame(1), isNull);
+    for (var id = 2; id < 5; id++) {
+      expect(anel.frame(id)!.data, everyElement(id));
+    }
+  });
+
+  test('a pinned frame survives the wrap-around until released', () {
+    var anel = AnelQuadrosLuma(capacity: 3, maxWidth: 4, maxHeight: 4);
+    anel.put(0, _plano(4, 4, 0), 4, 4);
+    expect(anel.pin(0), isTrue);
+    expect(anel.pinnedCount, 1);
+    for (var id = 1; id < 10; id++) {
+      anel.put(id, _plano(4, 4, id), 4, 4);
+    }
+    expect(anel.frame(0)!.data, everyElement(0));
+    expect(anel.frame(9)!.data, everyElement(9));
+
+    anel.release(0);
+    expect(anel.pinnedCount, 0);
+    anel.put(10, _plano(4, 4, 10), 4, 4);
+    anel.put(11, _plano(4, 4, 11), 4, 4);
+    expect(anel.frame(0), isNull);
+  });
+
+  test('a frame that left the ring cannot be pinned', () {
+    var anel = AnelQuadrosLuma(capacity: 2, maxWidth: 4, maxHeight: 4);
+    for (var id = 0; id < 3; id++) {
+      anel.put(id, _plano(4, 4, id), 4, 4);
+    }
+    expect(anel.pin(0), isFalse);
+    expect(anel.pin(-1), isFalse);
+    expect(anel.pinnedCount, 0);
+  });
+
+  test('frames are dropped when every slot is pinned or they do not fit', () {
+    var anel = AnelQuadrosLuma(capacity: 2, maxWidth: 4, maxHeight: 4);
+    anel.put(0, _plano(4, 4, 0), 4, 4);
+    anel.put(1, _plano(4, 4, 1), 4, 4);
+    anel
+      ..pin(0)
+      ..pin(1);
+    expect(anel.put(2, _plano(4, 4, 2), 4, 4), isFalse);
+    expect(anel.frame(0)!.data, everyElement(0));
+    expect(anel.frame(1)!.data, everyElement(1));
+
+    anel.releaseAll();
+    expect(anel.put(3, _plano(5, 4, 3), 5, 4), isFalse);
+    expect(anel.put(4, _plano(4, 4, 4, stride: 6), 4, 4, rowStride: 6, offset: 3), isFalse);
+    expect(anel.droppedFrames, 3);
+    expect(anel.put(5, _plano(4, 4, 5), 4, 4), isTrue);
+  });
+
+  test('the default slots hold a 4K frame', () {
+    var anel = AnelQuadrosLuma(capacity: 2);
+    expect(anel.put(0, Uint8List(3840 * 2160), 3840, 2160), isTrue);
+    expect(anel.droppedFrames, 0);
+  });
+}
@@ -0,0 +1,96 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/arrecadacao.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+// Utility bill with value identifier 6: every check digit modulo 10.
+const String _modulo10 = '83640000001331201380008128846271108013618155';
+
+// Bill with value identifier 8: every check digit modulo 11.
+const String _modulo11 = '85890000460524601791606075930508683148300001';
+
+List<int> _digitos(String barcode) => [for (var unit in barcode.codeUnits) unit - 0x30];
+
+String _texto(List<int> digits) => String.fromCharCodes(digits.map((digit) => digit + 0x30));
+
+// The general check digit straight from the FEBRABAN definition: the 43 digits other than position 4, weights from
+// the rightmost one, modulo 10 (2, 1, digits of the products summed) for identifiers 6 and 7, modulo 11 (2 to 9) for
+// 8 and 9; 10 and 11 give 0.
+int _digitoGeralDireto(List<int> barcode) {
+  var digits = [...barcode.sublist(0, 3), ...barcode.sublist(4)];
+  var soma = 0;
+  for (var i = 0; i < digits.length; i++) {
+    var digit = digits[digits.length - 1 - i];
+    if (barcode[2] <= 7) {
+      var produto = digit * (i.isEven ? 2 : 1);
+      soma += produto ~/ 10 + produto % 10;
+    } else {
+      soma += digit * (2 + i % 8);
+    }
+  }
+  var digito = (barcode[2] <= 7 ? 10 : 11) - soma % (barcode[2] <= 7 ? 10 : 11);
+  return digito > 9 ? 0 : digito;
+}
+
+void main() {
+  test('a modulo 10 bill converts with its block check digits', () {
+    var arrecadacao = converterArrecadacao(_modulo10);
+    expect(arrecadacao.isValid, isTrue);
+    expect(arrecadacao.linha, '83640000001-1 33120138000-2 81288462711-6 08013618155-1');
+    expect(arrecadacao.valorCentavos, 13312);
+  });
+
+  test('a modulo 11 bill converts with its block check digits', () {
+    var arrecadacao = converterArrecadacao(_modulo11);
+    expect(arrecadacao.isValid, isTrue);
+    expect(arrecadacao.linha, '85890000460-9 52460179160-5 60759305086-5 83148300001-0');
+    expect(arrecadacao.valorCentavos, 4605246);
+  });
+
+  test('a wrong general check digit fails', () {
+    for (var barcode in [_modulo10, _modulo11]) {
+      var digits = _digitos(barcode);
+      digits[3] = (digits[3] + 1) % 10;
+      expect(converterArrecadacao(_texto(digits)).isValid, isFalse, reason: barcode);
+    }
+  });
+
+  test('modulo 11 block check digits map remainders 0 and 1 to 0 and remainder 10 to 1', () {
+    expect(digitoArrecadacao(_digitos('58969350492'), 0, 11, 8), 0);
+    expect(digitoArrecadacao(_digitos('02734646869'), 0, 11, 9), 0);
+    expect(digitoArrecadacao(_digitos('32860129040'), 0, 11, 8), 1);
+    // The same block under modulo 10.
+    expect(digitoArrecadacao(_digitos('58969350492'), 0, 11, 6), 2);
+  });
+
+  test('the general check digit matches its definition for every value identifier', () {
+    var random = Random(46);
+    for (var identificador = 6; identificador <= 9; identificador++) {
+      for (var n = 0; n < 1000; n++) {
+        var digits = Uint8List.fromList(
+            [8, random.nextInt(10), identificador, 0, for (var i = 4; i < 44; i++) random.nextInt(10)]);
+        expect(digitoGeralArrecadacao(digits), _digitoGeralDireto(digits), reason: _texto(digits));
+      }
+    }
+  });
+
+  test('identifiers 7 and 9 carry a reference value instead of an amount', () {
+    for (var identificador in [7, 9]) {
+      var digits = _digitos(identificador == 7 ? _modulo10 : _modulo11);
+      digits[2] = identificador;
+      digits[3] = digitoGeralArrecadacao(digits);
+      var arrecadacao = converterArrecadacao(_texto(digits));
+      expect(arrecadacao.isValid, isTrue);
+      expect(arrecadacao.valorCentavos, isNull);
+    }
+  });
+
+  test('barcodes that are not arrecadação are rejected', () {
+    expect(converterArrecadacao('34191100000000123451101234567880057123457000').isValid, isFalse);
+    expect(converterArrecadacao(_modulo10.substring(0, 43)).isValid, isFalse);
+    var digits = _digitos(_modulo10);
+    digits[2] = 5;
+    expect(converterArrecadacao(_texto(digits)).isValid, isFalse);
+  });
+}
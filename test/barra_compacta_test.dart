@@ -0,0 +1,62 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+String _aleatorio(Random random) => String.fromCharCodes(List.generate(44, (_) => 0x30 + random.nextInt(10)));
+
+void main() {
+  test('toLinhaDigitavel renders the same line as calculaLinha', () {
+    var random = Random(30);
+    for (var i = 0; i < 2000; i++) {
+      var barcode = _aleatorio(random);
+      // Every other barcode gets a matching check digit; the rest mostly keep a mismatched one.
+      if (i.isEven) {
+        var digits = Uint8List.fromList(barcode.codeUnits.map((unit) => unit - 0x30).toList());
+        digits[4] = digitoModulo11Banco(digits);
+        barcode = String.fromCharCodes(digits.map((digit) => digit + 0x30));
+      }
+      expect(BarraCompacta.tryParse(barcode)!.toLinhaDigitavel(), calculaLinha(barcode), reason: barcode);
+    }
+  });
+
+  test('digitoModulo11Banco agrees with modulo11Banco', () {
+    var random = Random(31);
+    for (var i = 0; i < 2000; i++) {
+      var barcode = _aleatorio(random);
+      var digits = Uint8List.fromList(barcode.codeUnits.map((unit) => unit - 0x30).toList());
+      // modulo11Banco computes in doubles and returns e.g. "7.0", which calculaLinha splits on the dot as well.
+      var esperado = modulo11Banco(barcode.substring(0, 4) + barcode.substring(5)).split('.')[0];
+      expect(digitoModulo11Banco(digits).toString(), esperado, reason: barcode);
+    }
+  });
+
+  test('packing round-trips and orders like the digit strings', () {
+    var random = Random(32);
+    var barcodes = List.generate(500, (_) => _aleatorio(random));
+    var packed = barcodes.map((barcode) => BarraCompacta.tryParse(barcode)!).toList();
+    for (var i = 0; i < barcodes.length; i++) {
+      expect(packed[i].toString(), barcodes[i]);
+      expect(packed[i], BarraCompacta.tryParse(barcodes[i]));
+      expect(packed[i].compareTo(packed[(i + 1) % barcodes.length]).sign,
+          barcodes[i].compareTo(barcodes[(i + 1) % barcodes.length]).sign);
+    }
+    expect(BarraCompacta.tryParse('0' * 43 + 'x'), isNull);
+  });
+
+  test('ConjuntoBarras keeps each barcode once', () {
+    var random = Random(33);
+    var set = ConjuntoBarras();
+    var barcodes = List.generate(1000, (_) => _aleatorio(random));
+    for (var barcode in barcodes) {
+      expect(set.add(BarraCompacta.tryParse(barcode)!), isTrue);
+    }
+    for (var barcode in barcodes) {
+      expect(set.add(BarraCompacta.tryParse(barcode)!), isFalse);
+      expect(set.contains(BarraCompacta.tryParse(barcode)!), isTrue);
+    }
+    expect(set.length, barcodes.length);
+  });
+}
@@ -0,0 +1,105 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+import 'package:BarcodeCaptureSimpleSample/busca_ngram.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+// Smallest edit distance between `padrao` and any substring of `texto`, by the dynamic programming table.
+int _distanciaReferencia(List<int> padrao, List<int> texto) {
+  var anterior = List<int>.generate(padrao.length + 1, (i) => i);
+  var melhor = padrao.length;
+  for (var j = 0; j < texto.length; j++) {
+    // A match may start anywhere: the first row stays 0.
+    var atual = List<int>.filled(padrao.length + 1, 0);
+    for (var i = 1; i <= padrao.length; i++) {
+      var custo = padrao[i - 1] == texto[j] ? 0 : 1;
+      atual[i] = min(min(anterior[i - 1] + custo, anterior[i] + 1), atual[i - 1] + 1);
+    }
+    if (atual[padrao.length] < melhor) melhor = atual[padrao.length];
+    anterior = atual;
+  }
+  return melhor;
+}
+
+DiarioLeituras _journalAleatorio(Random random, int entradas) {
+  var journal = DiarioLeituras();
+  var digits = Uint8List(BarraCompacta.length);
+  var momento = DateTime(2024);
+  for (var i = 0; i < entradas; i++) {
+    for (var k = 0; k < 44; k++) {
+      digits[k] = random.nextInt(10);
+    }
+    digits[4] = digitoModulo11Banco(digits);
+    journal.add(BarraCompacta.fromDigits(digits)!, momento);
+  }
+  return journal;
+}
+
+// A fragment of a journal line with one random edit, or random digits.
+List<int> _fragmento(Random random, DiarioLeituras journal) {
+  var tamanho = 3 + random.nextInt(20);
+  if (random.nextInt(4) == 0) return List.generate(tamanho, (_) => random.nextInt(10));
+  var linha = journal.barcodeAt(random.nextInt(journal.length)).linhaDigitsInto(Uint8List(47));
+  var inicio = random.nextInt(47 - tamanho);
+  var fragmento = linha.sublist(inicio, inicio + tamanho).toList();
+  var posicao = random.nextInt(tamanho);
+  switch (random.nextInt(3)) {
+    case 0:
+      fragmento[posicao] = random.nextInt(10);
+      break;
+    case 1:
+      fragmento.removeAt(posicao);
+      break;
+    default:
+      fragmento.insert(posicao, random.nextInt(10));
+  }
+  return fragmento;
+}
+
+void main() {
+  test('buscar returns exactly the lines within the edit distance, as the DP reference', () {
+    var random = Random(48);
+    var journal = _journalAleatorio(random, 1500);
+    var indice = IndiceNGram(journal);
+    var linha = Uint8List(47);
+    for (var n = 0; n < 200; n++) {
+      var fragmento = _fragmento(random, journal);
+      var maxErros = n % 3 == 0 ? 2 : 1;
+      var esperado = <int, int>{};
+      for (var i = 0; i < journal.length; i++) {
+        var distancia = _distanciaReferencia(fragmento, journal.barcodeAt(i).linhaDigitsInto(linha));
+        if (distancia <= maxErros) esperado[i] = distancia;
+      }
+      var encontrado = {
+        for (var resultado in indice.buscar(fragmento.join(), maxErros: maxErros, limite: 1 << 30))
+          resultado.indice: resultado.distancia
+      };
+      expect(encontrado, esperado, reason: fragmento.join());
+    }
+  });
+
+  test('buscar ranks by distance, newest first among equals', () {
+    var random = Random(49);
+    var journal = _journalAleatorio(random, 300);
+    var fragmento = _fragmento(random, journal).join();
+    var resultados = IndiceNGram(journal).buscar(fragmento, maxErros: 2, limite: 1 << 30);
+    for (var i = 1; i < resultados.length; i++) {
+      var a = resultados[i - 1], b = resultados[i];
+      expect(a.distancia < b.distancia || (a.distancia == b.distancia && a.indice > b.indice), isTrue);
+    }
+  });
+
+  test('entries added after a query are found by the next one', () {
+    var random = Random(50);
+    var journal = _journalAleatorio(random, 200);
+    var indice = IndiceNGram(journal);
+    indice.buscar('12345678');
+    var novo = _journalAleatorio(random, 1).barcodeAt(0);
+    var indiceNovo = journal.add(novo, DateTime(2024));
+    var linha = novo.linhaDigitsInto(Uint8List(47)).sublist(10, 30).join();
+    expect(indice.buscar(linha, maxErros: 0).map((resultado) => resultado.indice), contains(indiceNovo));
+  });
+}
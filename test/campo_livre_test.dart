@@ -0,0 +1,100 @@
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+import 'package:BarcodeCaptureSimpleSample/campo_livre.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+Uint8List _digitos(String barcode) => Uint8List.fromList([for (var unit in barcode.codeUnits) unit - 0x30]);
+
+// A boleto of `banco` carrying `campoLivre` (25 digits), due date factor 1000, R$ 100,00 and its general check digit.
+Uint8List _barra(int banco, String campoLivre) {
+  var digits = _digitos('${banco.toString().padLeft(3, '0')}9010000000010000$campoLivre');
+  digits[4] = digitoModulo11Banco(digits);
+  return digits;
+}
+
+CampoLivre _ler(Uint8List digits) => lerCampoLivre(digits)!;
+
+void main() {
+  group('Itaú', () {
+    // Example of the Itaú boleto manual: agência/conta 0057/12345-7, carteira/nosso número 110/12345678-8.
+    const exemplo = '34199100000000123451101234567880057123457000';
+
+    test('the manual example is parsed and its DACs match', () {
+      var digits = _digitos(exemplo);
+      expect(digitoModulo11Banco(digits), 9);
+      var campo = _ler(digits);
+      expect([campo.carteira, campo.nossoNumero, campo.agencia, campo.conta], ['110', '12345678', '0057', '12345']);
+      expect(campo.digitosValidos, isTrue);
+    });
+
+    test('carteiras 126, 131, 146, 150 and 168 compute the nosso número DAC without agência and conta', () {
+      // DAC over carteira and nosso número, and over agência, conta, carteira and nosso número.
+      const dacs = {126: [5, 4], 131: [5, 4], 146: [3, 2], 150: [5, 4], 168: [7, 6]};
+      dacs.forEach((carteira, dac) {
+        expect(_ler(_barra(341, '${carteira}12345678${dac[0]}0057123457000')).digitosValidos, isTrue,
+            reason: 'carteira $carteira');
+        expect(_ler(_barra(341, '${carteira}12345678${dac[1]}0057123457000')).digitosValidos, isFalse,
+            reason: 'carteira $carteira');
+      });
+      // Any other carteira includes agência and conta.
+      expect(_ler(_barra(341, '1091234567800057123457000')).digitosValidos, isTrue);
+      expect(_ler(_barra(341, '1091234567810057123457000')).digitosValidos, isFalse);
+    });
+
+    test('a wrong conta DAC or trailing digit fails', () {
+      expect(_ler(_barra(341, '1101234567880057123456000')).digitosValidos, isFalse);
+      expect(_ler(_barra(341, '1101234567880057123457001')).digitosValidos, isFalse);
+    });
+  });
+
+  group('Caixa', () {
+    // SIGCB layout: beneficiário 005507-7, nosso número 14 000000000000019 (registrada, emitida pelo beneficiário).
+    const exemplo = '10497100000000100000055077000100040000000190';
+
+    test('the example is parsed and both mod 11 check digits match', () {
+      var digits = _digitos(exemplo);
+      expect(digitoModulo11Banco(digits), 7);
+      var campo = _ler(digits);
+      expect([campo.beneficiario, campo.nossoNumero, campo.carteira], ['005507', '14000000000000019', '1']);
+      expect(campo.digitosValidos, isTrue);
+      // A free field check digit other than 0, where 11 - remainder is not above 9.
+      expect(_ler(_barra(104, '0055077000100040000000239')).digitosValidos, isTrue);
+    });
+
+    test('each check digit is verified on its own', () {
+      // Beneficiário check digit wrong, free field check digit recomputed over it.
+      expect(_ler(_barra(104, '0055078000100040000000198')).digitosValidos, isFalse);
+      // Free field check digit wrong.
+      expect(_ler(_barra(104, '0055077000100040000000191')).digitosValidos, isFalse);
+    });
+  });
+
+  group('Santander', () {
+    // Beneficiário 0282033, nosso número 566612457800-2, IOF 0, carteira 102.
+    const exemplo = '03392100000000273509028203356661245780020102';
+
+    test('the example is parsed and its nosso número DV matches', () {
+      var digits = _digitos(exemplo);
+      expect(digitoModulo11Banco(digits), 2);
+      var campo = _ler(digits);
+      expect([campo.beneficiario, campo.nossoNumero, campo.carteira], ['0282033', '5666124578002', '102']);
+      expect(campo.digitosValidos, isTrue);
+    });
+
+    test('remainders 0 and 1 give DV 0 and remainder 10 gives DV 1', () {
+      expect(_ler(_barra(33, '9028203356661245780100102')).digitosValidos, isTrue);
+      expect(_ler(_barra(33, '9028203356661245780700102')).digitosValidos, isTrue);
+      expect(_ler(_barra(33, '9028203356661245780610102')).digitosValidos, isTrue);
+      expect(_ler(_barra(33, '9028203356661245780600102')).digitosValidos, isFalse);
+    });
+
+    test('a free field not starting with 9 fails', () {
+      expect(_ler(_barra(33, '8028203356661245780020102')).digitosValidos, isFalse);
+    });
+  });
+
+  test('banks without a parser have no free field', () {
+    expect(lerCampoLivre(_barra(748, '1234567890123456789012345')), isNull);
+  });
+}
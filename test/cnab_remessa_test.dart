@@ -0,0 +1,156 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+import 'package:BarcodeCaptureSimpleSample/cnab_remessa.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+import 'package:BarcodeCaptureSimpleSample/vencimento.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+const ContaCnab _conta = ContaCnab(
+    banco: 1,
+    nomeBanco: 'Banco do Brasil',
+    inscricao: 12345678000195,
+    agencia: 1234,
+    conta: 56789,
+    nomeEmpresa: 'Açaí Ltda');
+
+BarraCompacta _aleatorio(Random random, {bool mesmoBanco = false}) {
+  var digits = Uint8List.fromList(List.generate(44, (_) => random.nextInt(10)));
+  if (mesmoBanco) digits.setAll(0, [0, 0, 1]);
+  digits[4] = digitoModulo11Banco(digits);
+  return BarraCompacta.fromDigits(digits)!;
+}
+
+// The file split into its records, checking that each is 240 bytes followed by CRLF.
+List<String> _registros(Uint8List bytes) {
+  expect(bytes.length % 242, 0);
+  var registros = <String>[];
+  for (var inicio = 0; inicio < bytes.length; inicio += 242) {
+    expect(bytes.sublist(inicio + 240, inicio + 242), [0x0d, 0x0a], reason: 'record at $inicio');
+    var registro = String.fromCharCodes(bytes, inicio, inicio + 240);
+    expect(registro, isNot(anyOf(contains('\r'), contains('\n'))), reason: 'record at $inicio');
+    registros.add(registro);
+  }
+  return registros;
+}
+
+// Positions are 1-based and inclusive, as in the layout manual.
+String _campo(String registro, int de, int ate) => registro.substring(de - 1, ate);
+
+int _numero(String registro, int de, int ate) => int.parse(_campo(registro, de, ate));
+
+Uint8List _escrever(void Function(RemessaCnab240 remessa) corpo, {int registrosPorBloco = 256}) {
+  var bytes = BytesBuilder();
+  var remessa = RemessaCnab240(_conta, (bloco, length) => bytes.add(Uint8List.sublistView(bloco, 0, length)),
+      nsa: 7, geracao: DateTime(2024, 3, 1, 9, 5, 30), registrosPorBloco: registrosPorBloco);
+  corpo(remessa);
+  remessa.fechar();
+  return bytes.takeBytes();
+}
+
+void main() {
+  var diaPagamento = diaDeDateTime(DateTime(2024, 3, 1));
+
+  test('segment J carries the barcode, amounts, seu número and currency code in place', () {
+    var random = Random(49);
+    var boletos = List.generate(5, (_) => _aleatorio(random));
+    var registros = _registros(_escrever((remessa) {
+      remessa.iniciarLote(mesmoBanco: false);
+      for (var i = 0; i < boletos.length; i++) {
+        remessa.adicionar(boletos[i],
+            diaPagamento: diaPagamento, valorPagamento: i == 2 ? 12345 : null, seuNumero: i + 1);
+      }
+    }));
+    var segmentos = registros.where((registro) => registro[7] == '3').toList();
+    expect(segmentos, hasLength(5));
+    for (var i = 0; i < 5; i++) {
+      var registro = segmentos[i];
+      expect(_campo(registro, 1, 3), '001');
+      expect(_numero(registro, 4, 7), 1);
+      expect(_numero(registro, 9, 13), i + 1, reason: 'sequence number');
+      expect(_campo(registro, 14, 14), 'J');
+      expect(_campo(registro, 18, 61), boletos[i].toString());
+      expect(_numero(registro, 100, 114), boletos[i].valorCentavos);
+      expect(_campo(registro, 145, 152), '01032024');
+      expect(_numero(registro, 153, 167), i == 2 ? 12345 : boletos[i].valorCentavos);
+      expect(_numero(registro, 183, 202), i + 1);
+      expect(_campo(registro, 223, 224), '09');
+    }
+  });
+
+  test('headers identify the company, the bank and the file', () {
+    var registros = _registros(_escrever((remessa) => remessa.iniciarLote(mesmoBanco: true)));
+    var arquivo = registros.first;
+    expect(_campo(arquivo, 1, 8), '00100000');
+    expect(_numero(arquivo, 19, 32), 12345678000195);
+    expect(_campo(arquivo, 73, 102).trimRight(), 'A A  LTDA');
+    expect(_campo(arquivo, 103, 132).trimRight(), 'BANCO DO BRASIL');
+    expect(_campo(arquivo, 144, 157), '01032024090530');
+    expect(_numero(arquivo, 158, 163), 7);
+    var lote = registros[1];
+    expect(_campo(lote, 1, 9), '00100011C');
+    expect(_campo(lote, 12, 13), '30');
+  });
+
+  test('batch and file trailers count the records and total the amounts written', () {
+    var random = Random(50);
+    var journal = DiarioLeituras();
+    for (var i = 0; i < 40; i++) {
+      journal.add(_aleatorio(random, mesmoBanco: i % 4 == 0), DateTime(2024));
+    }
+    // Scanned twice, paid once.
+    journal.add(journal.barcodeAt(3), DateTime(2024));
+    var bytes = BytesBuilder();
+    escreverRemessa240(_conta, journal, (bloco, length) => bytes.add(Uint8List.sublistView(bloco, 0, length)),
+        nsa: 1, geracao: DateTime(2024, 3, 1), diaPagamento: diaPagamento);
+    var registros = _registros(bytes.takeBytes());
+
+    var lotes = 0, registrosLote = 0, valorLote = 0, segmentos = 0;
+    for (var registro in registros) {
+      switch (registro[7]) {
+        case '1':
+          lotes++;
+          expect(_numero(registro, 4, 7), lotes);
+          registrosLote = 1;
+          valorLote = 0;
+          break;
+        case '3':
+          segmentos++;
+          registrosLote++;
+          valorLote += _numero(registro, 153, 167);
+          break;
+        case '5':
+          registrosLote++;
+          expect(_numero(registro, 4, 7), lotes);
+          expect(_numero(registro, 18, 23), registrosLote);
+          expect(_numero(registro, 24, 41), valorLote);
+          break;
+      }
+    }
+    expect(lotes, 2);
+    expect(segmentos, 40);
+    var trailer = registros.last;
+    expect(_campo(trailer, 1, 8), '00199999');
+    expect(_numero(trailer, 18, 23), lotes);
+    expect(_numero(trailer, 24, 29), registros.length);
+  });
+
+  test('the file does not depend on the block size', () {
+    var random = Random(51);
+    var boletos = List.generate(20, (_) => _aleatorio(random));
+    void corpo(RemessaCnab240 remessa) {
+      remessa.iniciarLote(mesmoBanco: false);
+      for (var barcode in boletos) {
+        remessa.adicionar(barcode, diaPagamento: diaPagamento);
+      }
+    }
+
+    var referencia = _escrever(corpo);
+    for (var registrosPorBloco in [1, 2, 3, 7, 24]) {
+      expect(_escrever(corpo, registrosPorBloco: registrosPorBloco), referencia,
+          reason: '$registrosPorBloco records per block');
+    }
+  });
+}
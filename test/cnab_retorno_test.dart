@@ -0,0 +1,169 @@
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/barra_compacta.dart';
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+import 'package:BarcodeCaptureSimpleSample/cnab_remessa.dart';
+import 'package:BarcodeCaptureSimpleSample/cnab_retorno.dart';
+import 'package:BarcodeCaptureSimpleSample/diario_leituras.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+const ContaCnab _conta = ContaCnab(
+    banco: 1,
+    nomeBanco: 'Banco do Brasil',
+    inscricao: 12345678000195,
+    agencia: 1234,
+    conta: 56789,
+    nomeEmpresa: 'Empresa de Teste');
+
+const List<int> _tamanhosBloco = [240, 241, 242, 243, 1000, 1 << 20];
+
+BarraCompacta _aleatorio(Random random, {bool mesmoBanco = false}) {
+  var digits = Uint8List.fromList(List.generate(44, (_) => random.nextInt(10)));
+  if (mesmoBanco) digits.setAll(0, [0, 0, 1]);
+  digits[4] = digitoModulo11Banco(digits);
+  return BarraCompacta.fromDigits(digits)!;
+}
+
+DiarioLeituras _journalAleatorio(Random random, int entradas) {
+  var journal = DiarioLeituras();
+  for (var i = 0; i < entradas; i++) {
+    journal.add(_aleatorio(random, mesmoBanco: i % 3 == 0), DateTime(2024));
+  }
+  return journal;
+}
+
+// The payment file escreverRemessa240 writes for `journal`; its segment J records have the layout of a retorno.
+Uint8List _retorno(DiarioLeituras journal) {
+  var bytes = BytesBuilder();
+  escreverRemessa240(_conta, journal, (bloco, length) => bytes.add(Uint8List.sublistView(bloco, 0, length)),
+      nsa: 1, geracao: DateTime(2024, 3, 1), diaPagamento: 0);
+  return bytes.takeBytes();
+}
+
+// Offsets of the segment J records in a file of 240-byte records separated by CRLF.
+List<int> _segmentosJ(Uint8List bytes) => [
+      for (var inicio = 0; inicio + 240 <= bytes.length; inicio += 242)
+        if (bytes[inicio + 7] == 0x33 && bytes[inicio + 13] == 0x4a) inicio
+    ];
+
+void main() {
+  late Directory diretorio;
+  var arquivos = 0;
+
+  setUp(() async => diretorio = await Directory.systemTemp.createTemp('cnab_retorno_test'));
+  tearDown(() => diretorio.delete(recursive: true));
+
+  Future<String> gravar(List<int> bytes) async {
+    var arquivo = File('${diretorio.path}/retorno${arquivos++}.ret');
+    await arquivo.writeAsBytes(bytes);
+    return arquivo.path;
+  }
+
+  test('every record is read whatever the block size and line breaks', () async {
+    var journal = _journalAleatorio(Random(50), 300);
+    var bytes = _retorno(journal);
+    var semQuebras = [
+      for (var inicio = 0; inicio < bytes.length; inicio += 242) ...Uint8List.sublistView(bytes, inicio, inicio + 240)
+    ];
+    var soLf = [
+      for (var inicio = 0; inicio < bytes.length; inicio += 242) ...[
+        ...Uint8List.sublistView(bytes, inicio, inicio + 240),
+        0x0a
+      ]
+    ];
+    for (var conteudo in [bytes, semQuebras, soLf]) {
+      var caminho = await gravar(conteudo);
+      for (var tamanhoBloco in _tamanhosBloco) {
+        var conciliacao = (await conciliarRetorno(caminho, journal, tamanhoBloco: tamanhoBloco))!;
+        expect(conciliacao.registros, 300, reason: 'block $tamanhoBloco');
+        expect(conciliacao.conciliados, 300, reason: 'block $tamanhoBloco');
+        expect(conciliacao.naoRetornados, isEmpty, reason: 'block $tamanhoBloco');
+      }
+    }
+  });
+
+  test('a record cut short at the end of the file is not read', () async {
+    var journal = _journalAleatorio(Random(51), 100);
+    var bytes = _retorno(journal);
+    var ultimo = _segmentosJ(bytes).last;
+    var caminho = await gravar(Uint8List.sublistView(bytes, 0, ultimo + 100));
+    for (var tamanhoBloco in _tamanhosBloco) {
+      var conciliacao = (await conciliarRetorno(caminho, journal, tamanhoBloco: tamanhoBloco))!;
+      expect(conciliacao.registros, 99, reason: 'block $tamanhoBloco');
+      expect(conciliacao.naoRetornados, hasLength(1), reason: 'block $tamanhoBloco');
+    }
+  });
+
+  test('a returned boleto marks every scan of it and reports the latest', () async {
+    var random = Random(52);
+    var journal = _journalAleatorio(random, 10);
+    var repetido = _aleatorio(random);
+    for (var i = 0; i < 3; i++) {
+      journal.add(repetido, DateTime(2024));
+      journal.add(_aleatorio(random), DateTime(2024));
+    }
+    var pago = DiarioLeituras()..add(repetido, DateTime(2024));
+    var indices = <int>[];
+    var conciliacao = (await conciliarRetorno(await gravar(_retorno(pago)), journal,
+        conciliado: (registro) => indices.add(registro.indiceJournal)))!;
+    expect(indices, [14]);
+    expect(conciliacao.naoRetornados, isNot(anyOf(contains(10), contains(12), contains(14))));
+    expect(conciliacao.naoRetornados, hasLength(journal.length - 3));
+  });
+
+  test('records without a barcode are joined on the seu número', () async {
+    var random = Random(53);
+    var journal = _journalAleatorio(random, 50);
+    // The same boleto scanned again after the payment file was written.
+    journal.add(journal.barcodeAt(7), DateTime(2024));
+    var bytes = _retorno(journal);
+    var segmentos = _segmentosJ(bytes);
+    // Left blank by some banks and zeroed by others.
+    for (var k = 0; k < segmentos.length; k++) {
+      bytes.fillRange(segmentos[k] + 17, segmentos[k] + 61, k.isEven ? 0x20 : 0x30);
+    }
+    var indices = <int>[];
+    var conciliacao = (await conciliarRetorno(await gravar(bytes), journal,
+        conciliado: (registro) => indices.add(registro.indiceJournal)))!;
+    expect(conciliacao.conciliados, 50);
+    expect(indices, containsAll([50, for (var i = 0; i < 50; i++) if (i != 7) i]));
+    expect(conciliacao.naoRetornados, isEmpty);
+  });
+
+  test('a barcode missing from the journal is not joined on the seu número', () async {
+    var random = Random(54);
+    var journal = _journalAleatorio(random, 20);
+    var outros = _journalAleatorio(random, 20);
+    var conciliacao = (await conciliarRetorno(await gravar(_retorno(outros)), journal))!;
+    expect(conciliacao.registros, 20);
+    expect(conciliacao.naoEncontrados, 20);
+    expect(conciliacao.naoRetornados, hasLength(20));
+  });
+
+  test('a paid amount other than the barcode amount is divergent', () async {
+    var random = Random(55);
+    var journal = DiarioLeituras();
+    while (journal.length < 5) {
+      var barcode = _aleatorio(random);
+      if (barcode.valorCentavos > 0) journal.add(barcode, DateTime(2024));
+    }
+    var bytes = _retorno(journal);
+    var inicio = _segmentosJ(bytes)[2];
+    // Last digit of the paid amount, positions 153-167.
+    bytes[inicio + 166] = 0x30 + (bytes[inicio + 166] - 0x30 + 1) % 10;
+    var divergentes = <int>[];
+    var conciliacao = (await conciliarRetorno(await gravar(bytes), journal,
+        valorDivergente: (registro) => divergentes.add(registro.registro)))!;
+    expect(conciliacao.conciliados, 4);
+    expect(conciliacao.divergentes, 1);
+    expect(divergentes, [inicio ~/ 242 + 1]);
+  });
+
+  test('a file without a CNAB 240 header is not read', () async {
+    var journal = _journalAleatorio(Random(56), 5);
+    var cnab400 = '02RETORNO01COBRANCA'.padRight(394) + '000001\r\n';
+    expect(await conciliarRetorno(await gravar(cnab400.codeUnits), journal), isNull);
+  });
+}
@@ -0,0 +1,83 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/boleto.dart';
+import 'package:BarcodeCaptureSimpleSample/correcao.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+Uint8List _aleatorio(Random random) => Uint8List.fromList(List.generate(44, (_) => random.nextInt(10)));
+
+String _texto(Uint8List digits) => String.fromCharCodes(digits.map((digit) => digit + 0x30));
+
+bool _valido(Uint8List digits) => digitoModulo11Banco(digits) == digits[4];
+
+// Every single-digit substitution and adjacent transposition of `digits` that passes the check digit, by trying them
+// all.
+Set<String> _forcaBruta(Uint8List digits) {
+  var resultado = <String>{};
+  var scratch = Uint8List.fromList(digits);
+  for (var i = 0; i < 44; i++) {
+    for (var digit = 0; digit < 10; digit++) {
+      if (digit == digits[i]) continue;
+      scratch[i] = digit;
+      if (_valido(scratch)) resultado.add(_texto(scratch));
+    }
+    scratch[i] = digits[i];
+  }
+  for (var i = 0; i < 43; i++) {
+    if (digits[i] == digits[i + 1]) continue;
+    scratch[i] = digits[i + 1];
+    scratch[i + 1] = digits[i];
+    if (_valido(scratch)) resultado.add(_texto(scratch));
+    scratch[i] = digits[i];
+    scratch[i + 1] = digits[i + 1];
+  }
+  return resultado;
+}
+
+void main() {
+  test('enumerarCorrecoes finds exactly the candidates that pass the check digit', () {
+    var random = Random(36);
+    for (var n = 0; n < 500; n++) {
+      var digits = _aleatorio(random);
+      var candidatas = enumerarCorrecoes(digits).map((candidata) => candidata.barcode.toString()).toList();
+      expect(candidatas.toSet(), _forcaBruta(digits), reason: _texto(digits));
+      expect(candidatas.length, candidatas.toSet().length, reason: 'duplicates for ${_texto(digits)}');
+    }
+  });
+
+  test('a single misread digit or swap is among the corrections', () {
+    var random = Random(37);
+    for (var n = 0; n < 500; n++) {
+      var original = _aleatorio(random);
+      original[4] = digitoModulo11Banco(original);
+      var lido = Uint8List.fromList(original);
+      var posicao = random.nextInt(43);
+      if (n.isEven) {
+        lido[posicao] = (lido[posicao] + 1 + random.nextInt(9)) % 10;
+      } else {
+        lido[posicao] = original[posicao + 1];
+        lido[posicao + 1] = original[posicao];
+      }
+      if (_valido(lido)) continue;
+      var candidatas = enumerarCorrecoes(lido).map((candidata) => candidata.barcode.toString());
+      expect(candidatas, contains(_texto(original)), reason: _texto(lido));
+    }
+  });
+
+  test('ordenarCorrecoes puts the candidate agreeing with other reads first', () {
+    var random = Random(38);
+    var original = _aleatorio(random)
+      ..[0] = 3
+      ..[1] = 4
+      ..[2] = 1
+      ..[3] = 9;
+    original[4] = digitoModulo11Banco(original);
+    var lido = Uint8List.fromList(original);
+    for (var delta = 1; lido[30] == original[30] || _valido(lido); delta++) {
+      lido[30] = (original[30] + delta) % 10;
+    }
+    var ranking = ordenarCorrecoes(enumerarCorrecoes(lido), [original, original]);
+    expect(ranking.first.barcode.toString(), _texto(original));
+  });
+}
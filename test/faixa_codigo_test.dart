@@ -0,0 +1,95 @@
+import 'dart:io' show ZLibDecoder;
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:BarcodeCaptureSimpleSample/anel_quadros.dart';
+import 'package:BarcodeCaptureSimpleSample/faixa_codigo.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+QuadroLuma _quadroAleatorio(Random random, int width, int height) =>
+    QuadroLuma(0, width, height, Uint8List.fromList(List.generate(width * height, (_) => random.nextInt(256))));
+
+// Corners of the width x height region whose top left pixel is (x, y). Pixel i covers [i - 0.5, i + 0.5), so the
+// strip's pixel centers land exactly on the source pixels.
+List<double> _regiao(int x, int y, int width, int height) => [
+      x - 0.5,
+      y - 0.5,
+      x + width - 0.5,
+      y - 0.5,
+      x + width - 0.5,
+      y + height - 0.5,
+      x - 0.5,
+      y + height - 0.5
+    ];
+
+void main() {
+  test('rectifying an axis-aligned quadrilateral reproduces the source pixels', () {
+    var random = Random(27);
+    var frame = _quadroAleatorio(random, 64, 48);
+    for (var tamanho in [
+      [40, 8],
+      [37, 21],
+      [4, 30]
+    ]) {
+      var width = tamanho[0], height = tamanho[1];
+      var x = 1 + random.nextInt(64 - width - 2), y = 1 + random.nextInt(48 - height - 2);
+      var faixa = FaixaCodigo.rectify(frame, _regiao(x, y, width, height), height: height, margin: 0);
+      expect([faixa.width, faixa.height], [width, height]);
+      for (var row = 0; row < height; row++) {
+        var esperado = Uint8List.sublistView(frame.data, (y + row) * 64 + x, (y + row) * 64 + x + width);
+        expect(Uint8List.sublistView(faixa.pixels, row * width, (row + 1) * width), esperado,
+            reason: '${width}x$height at ($x, $y), row $row');
+      }
+    }
+  });
+
+  test('a quadrilateral given upside down yields the region rotated by 180 degrees', () {
+    var frame = _quadroAleatorio(Random(28), 32, 32);
+    var cantos = _regiao(5, 7, 20, 10);
+    var girados = [...cantos.sublist(4), ...cantos.sublist(0, 4)];
+    var faixa = FaixaCodigo.rectify(frame, girados, height: 10, margin: 0);
+    for (var row = 0; row < 10; row++) {
+      for (var col = 0; col < 20; col++) {
+        expect(faixa.pixels[row * 20 + col], frame.data[(16 - row) * 32 + 24 - col], reason: 'row $row, col $col');
+      }
+    }
+  });
+
+  test('the strip keeps the aspect ratio of the quadrilateral up to maxWidth', () {
+    var frame = _quadroAleatorio(Random(29), 200, 100);
+    expect(FaixaCodigo.rectify(frame, _regiao(10, 10, 160, 20), height: 32, margin: 0).width, 256);
+    expect(FaixaCodigo.rectify(frame, _regiao(10, 10, 160, 20), height: 32, maxWidth: 100, margin: 0).width, 100);
+  });
+
+  test('codificarPngCinza writes a PNG that decodes to the strip', () {
+    var random = Random(30);
+    var faixa = FaixaCodigo(37, 5, Uint8List.fromList(List.generate(37 * 5, (_) => random.nextInt(256))));
+    var png = codificarPngCinza(faixa);
+    expect(png.sublist(0, 8), [0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a]);
+
+    var view = ByteData.sublistView(png);
+    var chunks = <String, Uint8List>{};
+    for (var offset = 8; offset < png.length;) {
+      var length = view.getUint32(offset);
+      chunks[String.fromCharCodes(png, offset + 4, offset + 8)] =
+          Uint8List.sublistView(png, offset + 8, offset + 8 + length);
+      offset += 12 + length;
+    }
+    expect(chunks.keys, ['IHDR', 'IDAT', 'IEND']);
+    var ihdr = ByteData.sublistView(chunks['IHDR']!);
+    expect([ihdr.getUint32(0), ihdr.getUint32(4), ihdr.getUint8(8), ihdr.getUint8(9)], [37, 5, 8, 0]);
+
+    // Every row starts with its filter type: none for the first, "Up" (add the pixel above) for the others.
+    var filtrado = ZLibDecoder().convert(chunks['IDAT']!);
+    expect(filtrado, hasLength(38 * 5));
+    var pixels = Uint8List(37 * 5);
+    for (var row = 0; row < 5; row++) {
+      expect(filtrado[row * 38], row == 0 ? 0 : 2);
+      for (var col = 0; col < 37; col++) {
+        var acima = row == 0 ? 0 : pixels[(row - 1) * 37 + col];
+        pixels[row * 37 + col] = (filtrado[row * 38 + 1 + col] + acima) & 0xff;
+      }
+    }
+    expect(pixels, faixa.pixels);
+  });
+}
@@ -0,0 +1,26 @@
+import 'package:BarcodeCaptureSimpleSample/janela_recentes.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+void main() {
+  test('a key seen again within the window is a repeat, measured from its last sighting', () {
+    var janela = JanelaRecentes(Duration(seconds: 10));
+    var inicio = DateTime(2024);
+    expect(janela.repetida('pix', inicio), isFalse);
+    expect(janela.repetida('pix', inicio.add(Duration(seconds: 8))), isTrue);
+    // Still in view: every sighting moves the window along.
+    expect(janela.repetida('pix', inicio.add(Duration(seconds: 16))), isTrue);
+    expect(janela.repetida('pix', inicio.add(Duration(seconds: 27))), isFalse);
+    expect(janela.repetida('outro', inicio.add(Duration(seconds: 27))), isFalse);
+  });
+
+  test('the key not seen for the longest time is evicted first', () {
+    var janela = JanelaRecentes(Duration(seconds: 10), capacidade: 2);
+    var agora = DateTime(2024);
+    janela.repetida('a', agora);
+    janela.repetida('b', agora);
+    janela.repetida('a', agora);
+    janela.repetida('c', agora);
+    expect(janela.repetida('a', agora), isTrue);
+    expect(janela.repetida('b', agora), isFalse);
+  });
+}
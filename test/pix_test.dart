@@ -0,0 +1,56 @@
+import 'dart:math';
+
+import 'package:BarcodeCaptureSimpleSample/pix.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+// Bit-at-a-time CRC-16/CCITT-FALSE, the definition the slice-by-8 tables are built from.
+int _crcBitwise(List<int> data) {
+  var crc = 0xffff;
+  for (var byte in data) {
+    crc ^= byte << 8;
+    for (var k = 0; k < 8; k++) {
+      crc = (crc & 0x8000) != 0 ? ((crc << 1) ^ 0x1021) & 0xffff : (crc << 1) & 0xffff;
+    }
+  }
+  return crc;
+}
+
+// Static BR Code from the Banco Central's BR Code manual.
+const String _exemploManual = '00020126580014br.gov.bcb.pix0136123e4567-e12b-12d1-a456-426655440000520400005303986'
+    '5802BR5913Fulano de Tal6008BRASILIA62070503***63041D3D';
+
+void main() {
+  test('crc16Ccitt matches the check value and the bitwise CRC', () {
+    expect(crc16Ccitt('123456789'.codeUnits), 0x29b1);
+    var random = Random(35);
+    for (var length = 0; length < 300; length++) {
+      var data = List.generate(length, (_) => random.nextInt(256));
+      expect(crc16Ccitt(data), _crcBitwise(data), reason: 'length $length');
+    }
+  });
+
+  test('lerPix reads the manual example', () {
+    var pix = lerPix(_exemploManual)!;
+    expect(pix.chave, '123e4567-e12b-12d1-a456-426655440000');
+    expect(pix.nomeRecebedor, 'Fulano de Tal');
+    expect(pix.cidade, 'BRASILIA');
+    expect(pix.txid, '***');
+    expect(pix.valorCentavos, isNull);
+    expect(pix.crcValido, isTrue);
+  });
+
+  test('lerPix reads amount and txid and flags a wrong CRC', () {
+    const payload = '00020126580014br.gov.bcb.pix0136123e4567-e12b-12d1-a456-426655440000520400005303986'
+        '54071234.565802BR5913Fulano de Tal6008BRASILIA62140510TXID12345663049D99';
+    var pix = lerPix(payload)!;
+    expect(pix.valorCentavos, 123456);
+    expect(pix.txid, 'TXID123456');
+    expect(pix.crcValido, isTrue);
+    expect(lerPix(payload.replaceFirst('1234.56', '1234.57'))!.crcValido, isFalse);
+  });
+
+  test('lerPix rejects what is not a Pix BR Code', () {
+    expect(lerPix('https://example.com'), isNull);
+    expect(lerPix(_exemploManual.substring(0, 40)), isNull);
+  });
+}
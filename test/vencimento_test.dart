@@ -0,0 +1,87 @@
+import 'package:BarcodeCaptureSimpleSample/vencimento.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+int _data(int fator, DateTime hoje) => dataDoDia(diaDoFator(fator, diaDeDateTime(hoje)));
+
+void main() {
+  test('days count from 1997-10-07', () {
+    expect(diaDaData(1997, 10, 7), 0);
+    expect(dataDoDia(0), 19971007);
+    expect(dataDoDia(1000), 20000703);
+    expect(diaDeDateTime(DateTime(2025, 2, 22)), diaReinicioFator);
+    expect(dataDoDia(-1), 0);
+    expect(dataDoDia(totalDias), 0);
+  });
+
+  test('factor 9999 is 2025-02-21 and factor 1000 restarts on 2025-02-22', () {
+    expect(_data(9999, DateTime(2025, 2, 1)), 20250221);
+    expect(_data(1000, DateTime(2025, 2, 1)), 20250222);
+    expect(_data(1000, DateTime(2025, 6, 1)), 20250222);
+    expect(_data(1001, DateTime(2025, 2, 21)), 20250223);
+    // The first cycle still wins for a reference day in it.
+    expect(_data(1000, DateTime(2000, 6, 1)), 20000703);
+    expect(_data(9999, DateTime(2030, 1, 1)), 20250221);
+  });
+
+  test('factor 0 and factors outside 1-9999 have no due date', () {
+    var hoje = diaDeDateTime(DateTime(2025, 3, 1));
+    expect(diaDoFator(0, hoje), -1);
+    expect(diaDoFator(10000, hoje), -1);
+  });
+
+  test('carnival Monday and Tuesday, Good Friday and Corpus Christi are holidays', () {
+    // Easter was on 2024-03-31 and on 2025-04-20.
+    for (var data in [
+      DateTime(2024, 2, 12),
+      DateTime(2024, 2, 13),
+      DateTime(2024, 3, 29),
+      DateTime(2024, 5, 30),
+      DateTime(2025, 3, 3),
+      DateTime(2025, 3, 4),
+      DateTime(2025, 4, 18),
+      DateTime(2025, 6, 19),
+    ]) {
+      expect(ehFeriado(diaDeDateTime(data)), isTrue, reason: '$data');
+      expect(ehDiaUtil(diaDeDateTime(data)), isFalse, reason: '$data');
+    }
+    // Ash Wednesday and Easter Monday are business days.
+    expect(ehDiaUtil(diaDeDateTime(DateTime(2024, 2, 14))), isTrue);
+    expect(ehDiaUtil(diaDeDateTime(DateTime(2024, 4, 1))), isTrue);
+  });
+
+  test('November 20 is a holiday from 2024 on', () {
+    // Monday in 2023, Wednesday in 2024, Thursday in 2025.
+    expect(ehDiaUtil(diaDeDateTime(DateTime(2023, 11, 20))), isTrue);
+    expect(ehFeriado(diaDeDateTime(DateTime(2024, 11, 20))), isTrue);
+    expect(ehFeriado(diaDeDateTime(DateTime(2025, 11, 20))), isTrue);
+  });
+
+  test('weekends are not business days but not holidays either', () {
+    var sabado = diaDeDateTime(DateTime(2024, 6, 8));
+    expect(ehDiaUtil(sabado), isFalse);
+    expect(ehFeriado(sabado), isFalse);
+    expect(ehDiaUtil(sabado + 2), isTrue);
+  });
+
+  test('proximoDiaUtil skips a carnival weekend to Ash Wednesday', () {
+    var sexta = diaDeDateTime(DateTime(2024, 2, 9));
+    expect(proximoDiaUtil(sexta), sexta);
+    for (var dia = sexta + 1; dia <= sexta + 4; dia++) {
+      expect(dataDoDia(proximoDiaUtil(dia)), 20240214, reason: formatarData(dataDoDia(dia)));
+    }
+    // Good Friday, then the weekend.
+    expect(dataDoDia(proximoDiaUtil(diaDeDateTime(DateTime(2024, 3, 29)))), 20240401);
+  });
+
+  test('a boleto due on a non-business day is payable without charges on the next business day', () {
+    var vencimento = diaDeDateTime(DateTime(2024, 2, 10));
+    expect(pagavelSemEncargos(vencimento, diaDeDateTime(DateTime(2024, 2, 14))), isTrue);
+    expect(pagavelSemEncargos(vencimento, diaDeDateTime(DateTime(2024, 2, 15))), isFalse);
+    expect(pagavelSemEncargos(vencimento, vencimento - 1), isTrue);
+  });
+
+  test('dates are formatted as DD/MM/AAAA', () {
+    expect(formatarData(20250222), '22/02/2025');
+    expect(formatarData(19971007), '07/10/1997');
+  });
+}